@@ -0,0 +1,77 @@
+// Copyright 2020 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+
+using namespace lime;
+
+static const std::string filename = "bench_file.h5";
+
+void bench_file_h5_append(long n_samples, int repetitions) {
+  for_each_family([&](std::string name, auto const &entry) {
+    benchmark(
+        "FileH5 << " + name, n_samples, n_samples * entry_bytes(entry),
+        repetitions, [] { remove(filename.c_str()); },
+        [&] {
+          auto file = FileH5(filename, "w");
+          for (long idx = 0; idx < n_samples; ++idx)
+            file["field"] << entry;
+          file.close();
+        });
+  });
+  remove(filename.c_str());
+}
+
+void bench_file_h5_read(long n_samples, int repetitions) {
+  for_each_family([&](std::string name, auto const &entry) {
+    using data_t = std::decay_t<decltype(entry)>;
+    remove(filename.c_str());
+    auto file = FileH5(filename, "w");
+    std::vector<data_t> entries(n_samples, entry);
+    file.append("field", entries);
+    file.close();
+
+    std::vector<data_t> read_entries;
+    benchmark("FileH5::read " + name, n_samples,
+              n_samples * entry_bytes(entry), repetitions, [&] {
+                auto file = FileH5(filename, "r");
+                file.read("field", read_entries);
+                file.close();
+              });
+  });
+  remove(filename.c_str());
+}
+
+void bench_file_h5_open(std::vector<long> const &n_fields, int repetitions) {
+  for (long n : n_fields) {
+    remove(filename.c_str());
+    auto file = FileH5(filename, "w");
+    for (long idx = 0; idx < n; ++idx)
+      file["group" + std::to_string(idx % 10) + "/field" +
+           std::to_string(idx)] << (double)idx;
+    file.close();
+
+    // Opening a single group only indexes its fields
+    benchmark("FileH5 open, fields: " + std::to_string(n), n, 0.,
+              repetitions, [&] { FileH5(filename, "r").close(); });
+    benchmark("FileH5 open group, fields: " + std::to_string(n / 10),
+              n / 10, 0., repetitions,
+              [&] { FileH5(filename, "r", "group0").close(); });
+  }
+  remove(filename.c_str());
+}
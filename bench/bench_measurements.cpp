@@ -0,0 +1,91 @@
+// Copyright 2020 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+
+using namespace lime;
+
+static const std::string filename = "bench_file.h5";
+
+void bench_measurements_append(long n_samples, int repetitions) {
+  for_each_family([&](std::string name, auto const &entry) {
+    benchmark("Measurements::append " + name, n_samples,
+              n_samples * entry_bytes(entry), repetitions, [&] {
+                Measurements measurements;
+                for (long idx = 0; idx < n_samples; ++idx)
+                  measurements["field"] << entry;
+              });
+  });
+}
+
+// Dumps after every n_pending appends of ten scalar and vector fields
+void bench_measurements_dump(long n_samples,
+                             std::vector<long> const &n_pending,
+                             int repetitions) {
+  dvector vec(16);
+  for (int i = 0; i < 16; ++i)
+    vec(i) = i;
+  double sample_bytes = 10 * (sizeof(double) + 16 * sizeof(double));
+  for (long pending : n_pending) {
+    benchmark(
+        "Measurements::dump, pending: " + std::to_string(pending), n_samples,
+        n_samples * sample_bytes, repetitions,
+        [] { remove(filename.c_str()); },
+        [&] {
+          auto file = FileH5(filename, "w");
+          Measurements measurements;
+          for (long idx = 0; idx < n_samples; ++idx) {
+            for (int f = 0; f < 10; ++f) {
+              measurements["scalar" + std::to_string(f)] << (double)idx;
+              measurements["vector" + std::to_string(f)] << vec;
+            }
+            if ((idx + 1) % pending == 0)
+              measurements.dump(file);
+          }
+          measurements.dump(file);
+          file.close();
+        });
+  }
+  remove(filename.c_str());
+}
+
+void bench_measurements_read(long n_samples, int repetitions) {
+  dvector vec(16);
+  for (int i = 0; i < 16; ++i)
+    vec(i) = i;
+  remove(filename.c_str());
+  auto file = FileH5(filename, "w");
+  Measurements measurements;
+  for (long idx = 0; idx < n_samples; ++idx)
+    for (int f = 0; f < 10; ++f) {
+      measurements["scalar" + std::to_string(f)] << (double)idx;
+      measurements["vector" + std::to_string(f)] << vec;
+    }
+  measurements.dump(file);
+  file.close();
+
+  double sample_bytes = 10 * (sizeof(double) + 16 * sizeof(double));
+  benchmark("Measurements::read", n_samples, n_samples * sample_bytes,
+            repetitions, [&] {
+              auto file = FileH5(filename, "r");
+              Measurements read_measurements;
+              read_measurements.read(file);
+              file.close();
+            });
+  remove(filename.c_str());
+}
@@ -0,0 +1,82 @@
+// Copyright 2020 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIME_BENCH_BENCHMARK_H
+#define LIME_BENCH_BENCHMARK_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#include <lime/all.h>
+
+// Runs f repeatedly and reports the throughput of the fastest repetition,
+// f processes n_samples samples of n_bytes in total. Setup which should
+// not be timed is done by prepare before every repetition.
+template <class Prepare, class F>
+void benchmark(std::string name, long n_samples, double n_bytes,
+               int repetitions, Prepare prepare, F f) {
+  using clock = std::chrono::steady_clock;
+  double best = 0.;
+  for (int rep = 0; rep < repetitions; ++rep) {
+    prepare();
+    auto start = clock::now();
+    f();
+    double seconds =
+        std::chrono::duration<double>(clock::now() - start).count();
+    best = (rep == 0) ? seconds : std::min(best, seconds);
+  }
+  best = std::max(best, 1e-9);
+  std::printf("%-40s %10ld %14.0f samples/s %10.2f MB/s\n", name.c_str(),
+              n_samples, n_samples / best, n_bytes / best / 1e6);
+  std::fflush(stdout);
+}
+
+template <class F>
+void benchmark(std::string name, long n_samples, double n_bytes,
+               int repetitions, F f) {
+  benchmark(name, n_samples, n_bytes, repetitions, [] {}, f);
+}
+
+// Calls f(name, entry) with a deterministic entry of every type family
+template <class F> void for_each_family(F f) {
+  lime::dvector vec(16);
+  for (int i = 0; i < 16; ++i)
+    vec(i) = i;
+  lime::dmatrix mat(8, 8);
+  for (int i = 0; i < 8; ++i)
+    for (int j = 0; j < 8; ++j)
+      mat(i, j) = i + 8 * j;
+  lime::BoolVector bits(256);
+  for (int i = 0; i < 256; i += 3)
+    bits.set(i, true);
+  lime::dtensor tensor({4, 4, 4});
+  for (int i = 0; i < 64; ++i)
+    tensor.data()[i] = i;
+  lime::Record record;
+  for (int i = 0; i < 8; ++i)
+    record.set("observable" + std::to_string(i), (double)i);
+
+  f("int", 42);
+  f("double", 1.5);
+  f("complex", lime::zscalar(1.5, -0.5));
+  f("dvector(16)", vec);
+  f("dmatrix(8x8)", mat);
+  f("bvector(256)", bits);
+  f("dtensor(4x4x4)", tensor);
+  f("record(8)", record);
+}
+
+#endif
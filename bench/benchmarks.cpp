@@ -0,0 +1,48 @@
+// Copyright 2020 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+void bench_file_h5_append(long n_samples, int repetitions);
+void bench_file_h5_read(long n_samples, int repetitions);
+void bench_file_h5_open(std::vector<long> const &n_fields, int repetitions);
+void bench_measurements_append(long n_samples, int repetitions);
+void bench_measurements_dump(long n_samples,
+                             std::vector<long> const &n_pending,
+                             int repetitions);
+void bench_measurements_read(long n_samples, int repetitions);
+
+// Microbenchmarks of the hot paths of FileH5 and Measurements. All inputs
+// are deterministic, the fastest of several repetitions is reported.
+// Usage: benchmarks [n_samples] [repetitions]
+int main(int argc, char *argv[]) {
+  long n_samples = (argc > 1) ? std::atol(argv[1]) : 10000;
+  int repetitions = (argc > 2) ? std::atoi(argv[2]) : 3;
+  if ((n_samples < 1) || (repetitions < 1)) {
+    std::cerr << "Usage: benchmarks [n_samples] [repetitions]\n";
+    return EXIT_FAILURE;
+  }
+
+  bench_file_h5_append(n_samples, repetitions);
+  bench_file_h5_read(n_samples, repetitions);
+  bench_file_h5_open({100, 1000, 10000}, repetitions);
+  bench_measurements_append(n_samples, repetitions);
+  bench_measurements_dump(n_samples, {1, 100, n_samples}, repetitions);
+  bench_measurements_read(n_samples, repetitions);
+  return EXIT_SUCCESS;
+}
@@ -22,11 +22,28 @@
 #include "measurements.h"
 #include "measurement_handler.h"
 #include "type_string.h"
+#include "field_traits.h"
+#include "field_storage.h"
+#include "file_h5_options.h"
+#include "io_stats.h"
+#include "chunk_cache.h"
 #include "types.h"
+#include "bool_vector.h"
+#include "record.h"
+#include "tensor.h"
+#include "view.h"
 #include "filesystem.h"
+#include "append_log.h"
+#include "mapped_field.h"
+#include "repack.h"
+#include "merge.h"
+#include "query.h"
+#include "catalog.h"
+#include "attribute_traits.h"
 
 #include "hdf5/utils.h"
 #include "hdf5/types.h"
+#include "hdf5/field_scope.h"
 #include "hdf5/parse_file.h"
 
 #include "hdf5/create_static_field.h"
@@ -40,5 +57,8 @@
 
 #include "hdf5/append_compatible.h"
 #include "hdf5/append_extensible_field.h"
+#include "hdf5/read_hyperslab.h"
+#include "hdf5/read_into.h"
+#include "hdf5/read_member.h"
 
 #endif
@@ -0,0 +1,254 @@
+#include "append_log.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
+#include <fstream>
+#include <iterator>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define LIME_APPEND_LOG_MAGIC "LIMELOG1"
+#define LIME_APPEND_LOG_MAGIC_SIZE 8
+
+namespace lime {
+
+// FNV-1a checksum to detect torn records
+static uint32_t checksum(const char *data, size_t nbytes) {
+  uint32_t hash = 2166136261u;
+  for (size_t idx = 0; idx < nbytes; ++idx) {
+    hash ^= (uint8_t)data[idx];
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+template <class int_t> static void put(std::vector<char> &buffer, int_t val) {
+  const char *ptr = reinterpret_cast<const char *>(&val);
+  buffer.insert(buffer.end(), ptr, ptr + sizeof(int_t));
+}
+
+template <class int_t>
+static bool get(const char *&ptr, const char *end, int_t &val) {
+  if ((size_t)(end - ptr) < sizeof(int_t))
+    return false;
+  std::memcpy(&val, ptr, sizeof(int_t));
+  ptr += sizeof(int_t);
+  return true;
+}
+
+static bool get(const char *&ptr, const char *end, std::string &str) {
+  uint32_t len;
+  if (!get(ptr, end, len) || ((size_t)(end - ptr) < len))
+    return false;
+  str.assign(ptr, len);
+  ptr += len;
+  return true;
+}
+
+static void write_all(int fd, const char *data, size_t nbytes,
+                      std::string const &filename) {
+  while (nbytes > 0) {
+    ssize_t written = ::write(fd, data, nbytes);
+    if (written < 0) {
+      if (errno == EINTR)
+        continue;
+      ::close(fd);
+      auto msg = std::string("Lime error: can't write to log: ") + filename;
+      throw std::runtime_error(msg);
+    }
+    data += written;
+    nbytes -= written;
+  }
+}
+
+AppendLog::AppendLog(std::string filename) : filename_(filename) {}
+
+void AppendLog::write(std::string field, long index, Record const &data) {
+  hid_t datatype_id = data.create_datatype();
+  size_t encoded_size = 0;
+  H5Tencode(datatype_id, NULL, &encoded_size);
+  std::string types = data.member_types();
+  std::vector<char> bytes(encoded_size + types.size() + data.nbytes());
+  H5Tencode(datatype_id, bytes.data(), &encoded_size);
+  H5Tclose(datatype_id);
+  std::copy(types.begin(), types.end(), bytes.begin() + encoded_size);
+  std::copy(data.data(), data.data() + data.nbytes(),
+            bytes.begin() + encoded_size + types.size());
+  write_record(field, type_string(data), index,
+               {(int64_t)encoded_size, (int64_t)types.size()}, bytes.data(),
+               bytes.size());
+}
+
+// Records are logged as their encoded datatype, the member types (not in
+// logs written before) and the member values
+void read_record(AppendLogRecord const &record, Record &data) {
+  auto const &shape = record.shape;
+  if ((shape.size() < 1) || (shape.size() > 2) || (shape[0] < 0) ||
+      ((shape.size() == 2) && (shape[1] < 0)) ||
+      (record.bytes.size() <
+       (size_t)shape[0] + (shape.size() == 2 ? (size_t)shape[1] : 0)))
+    throw std::runtime_error("Lime error: invalid record in log for field: " +
+                             record.field);
+  size_t offset = (size_t)shape[0];
+  std::string types;
+  if (shape.size() == 2) {
+    types.assign(record.bytes.begin() + offset,
+                 record.bytes.begin() + offset + shape[1]);
+    offset += (size_t)shape[1];
+  }
+  hid_t datatype_id = H5Tdecode(record.bytes.data());
+  if (datatype_id < 0)
+    throw std::runtime_error("Lime error: invalid record in log for field: " +
+                             record.field);
+  data = Record::from_datatype(datatype_id, types);
+  H5Tclose(datatype_id);
+  if (record.bytes.size() - offset != data.nbytes())
+    throw std::runtime_error("Lime error: invalid record in log for field: " +
+                             record.field);
+  std::copy(record.bytes.begin() + offset, record.bytes.end(), data.data());
+}
+
+void AppendLog::write_record(std::string const &field, std::string const &type,
+                             long index, std::vector<int64_t> const &shape,
+                             const void *data, size_t nbytes) {
+  std::vector<char> payload;
+  put(payload, (uint32_t)field.size());
+  payload.insert(payload.end(), field.begin(), field.end());
+  put(payload, (uint32_t)type.size());
+  payload.insert(payload.end(), type.begin(), type.end());
+  put(payload, (int64_t)index);
+  put(payload, (uint32_t)shape.size());
+  for (auto dim : shape)
+    put(payload, dim);
+  put(payload, (uint64_t)nbytes);
+  const char *bytes = static_cast<const char *>(data);
+  payload.insert(payload.end(), bytes, bytes + nbytes);
+
+  put(buffer_, (uint64_t)payload.size());
+  put(buffer_, checksum(payload.data(), payload.size()));
+  buffer_.insert(buffer_.end(), payload.begin(), payload.end());
+}
+
+void AppendLog::sync() {
+  int fd = ::open(filename_.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+  if (fd < 0) {
+    auto msg = std::string("Lime error: can't open log: ") + filename_;
+    throw std::runtime_error(msg);
+  }
+
+  // A new log starts with the magic string
+  struct stat st;
+  if ((fstat(fd, &st) == 0) && (st.st_size == 0))
+    write_all(fd, LIME_APPEND_LOG_MAGIC, LIME_APPEND_LOG_MAGIC_SIZE, filename_);
+
+  write_all(fd, buffer_.data(), buffer_.size(), filename_);
+  if (fsync(fd) != 0) {
+    ::close(fd);
+    auto msg = std::string("Lime error: can't sync log: ") + filename_;
+    throw std::runtime_error(msg);
+  }
+  ::close(fd);
+  buffer_.clear();
+}
+
+void AppendLog::clear() {
+  int fd = ::open(filename_.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    auto msg = std::string("Lime error: can't open log: ") + filename_;
+    throw std::runtime_error(msg);
+  }
+  fsync(fd);
+  ::close(fd);
+  buffer_.clear();
+}
+
+// Records of the content of a log up to the first torn or corrupted
+// record, end_offset is set to the end of the last valid record
+static std::vector<AppendLogRecord>
+parse_records(std::vector<char> const &content, std::string const &filename,
+              size_t &end_offset) {
+  std::vector<AppendLogRecord> records;
+  end_offset = 0;
+  // A log torn while writing its magic string holds no records
+  if ((content.size() < LIME_APPEND_LOG_MAGIC_SIZE) &&
+      (std::string(LIME_APPEND_LOG_MAGIC)
+           .compare(0, content.size(), content.data(), content.size()) == 0))
+    return records;
+  if ((content.size() < LIME_APPEND_LOG_MAGIC_SIZE) ||
+      (std::string(content.data(), LIME_APPEND_LOG_MAGIC_SIZE) !=
+       LIME_APPEND_LOG_MAGIC)) {
+    auto msg = std::string("Lime error: invalid log file: ") + filename;
+    throw std::runtime_error(msg);
+  }
+
+  const char *ptr = content.data() + LIME_APPEND_LOG_MAGIC_SIZE;
+  const char *end = content.data() + content.size();
+  end_offset = LIME_APPEND_LOG_MAGIC_SIZE;
+  while (ptr < end) {
+    // Stop at the first torn or corrupted record
+    uint64_t payload_size;
+    uint32_t payload_checksum;
+    if (!get(ptr, end, payload_size) || !get(ptr, end, payload_checksum) ||
+        ((uint64_t)(end - ptr) < payload_size) ||
+        (checksum(ptr, payload_size) != payload_checksum))
+      break;
+
+    const char *payload_end = ptr + payload_size;
+    AppendLogRecord record;
+    int64_t index;
+    uint32_t ndims;
+    uint64_t nbytes;
+    bool valid = get(ptr, payload_end, record.field) &&
+                 get(ptr, payload_end, record.type) &&
+                 get(ptr, payload_end, index) && get(ptr, payload_end, ndims);
+    for (uint32_t dim = 0; valid && (dim < ndims); ++dim) {
+      int64_t size;
+      valid = get(ptr, payload_end, size);
+      record.shape.push_back(size);
+    }
+    valid = valid && get(ptr, payload_end, nbytes) &&
+            ((uint64_t)(payload_end - ptr) == nbytes);
+    if (!valid)
+      break;
+    record.index = (long)index;
+    record.bytes.assign(ptr, payload_end);
+    records.push_back(record);
+    ptr = payload_end;
+    end_offset = (size_t)(ptr - content.data());
+  }
+  return records;
+}
+
+static std::vector<char> read_content(std::string const &filename) {
+  std::ifstream inf(filename, std::ios::binary);
+  if (!inf.good())
+    return std::vector<char>();
+  return std::vector<char>((std::istreambuf_iterator<char>(inf)),
+                           std::istreambuf_iterator<char>());
+}
+
+std::vector<AppendLogRecord> AppendLog::records() const {
+  size_t end_offset;
+  return parse_records(read_content(filename_), filename_, end_offset);
+}
+
+std::vector<AppendLogRecord> AppendLog::repair() {
+  auto content = read_content(filename_);
+  size_t end_offset;
+  auto records = parse_records(content, filename_, end_offset);
+  if (end_offset < content.size()) {
+    int fd = ::open(filename_.c_str(), O_WRONLY);
+    if ((fd < 0) || (ftruncate(fd, (off_t)end_offset) != 0) ||
+        (fsync(fd) != 0)) {
+      if (fd >= 0)
+        ::close(fd);
+      auto msg = std::string("Lime error: can't repair log: ") + filename_;
+      throw std::runtime_error(msg);
+    }
+    ::close(fd);
+  }
+  return records;
+}
+
+} // namespace lime
@@ -0,0 +1,120 @@
+// Copyright 2020 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIME_APPEND_LOG_H
+#define LIME_APPEND_LOG_H
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <lime/field_traits.h>
+#include <lime/type_string.h>
+
+namespace lime {
+
+// A single measurement as stored in an AppendLog
+struct AppendLogRecord {
+  std::string field;
+  std::string type;
+  long index;
+  std::vector<int64_t> shape;
+  std::vector<char> bytes;
+};
+
+// Sequential binary log of measurements. Records are buffered by write(...)
+// and appended to the log file with a single write and fsync by sync().
+// Records that have been torn by a crash while syncing are detected by a
+// checksum and ignored when reading the log back.
+class AppendLog {
+public:
+  AppendLog() = default;
+  AppendLog(std::string filename);
+
+  inline std::string filename() const { return filename_; }
+
+  template <class data_t>
+  void write(std::string field, long index, data_t const &data) {
+    using traits = field_traits<data_t>;
+    std::vector<int64_t> shape;
+    size_t nbytes = sizeof(typename traits::coeff_type);
+    for (auto dim : traits::shape(data)) {
+      shape.push_back((int64_t)dim);
+      nbytes *= dim;
+    }
+
+    // Packed entries are recorded with their number of values
+    if constexpr (traits::packed)
+      shape = {(int64_t)traits::bit_count(data)};
+    write_record(field, type_string(data), index, shape, traits::data(data),
+                 nbytes);
+  }
+
+  // Records are logged with their encoded compound datatype as a prefix of
+  // their data, the shape holds the size of the encoded datatype
+  void write(std::string field, long index, Record const &data);
+
+  void sync();
+  void clear();
+  std::vector<AppendLogRecord> records() const;
+
+  // Records of the log, a torn tail left by a crash is cut off such that
+  // later records are appended behind the last valid one
+  std::vector<AppendLogRecord> repair();
+
+private:
+  std::string filename_;
+  std::vector<char> buffer_;
+
+  void write_record(std::string const &field, std::string const &type,
+                    long index, std::vector<int64_t> const &shape,
+                    const void *data, size_t nbytes);
+};
+
+// Decodes the data of a record, shapes are stored in the index order of
+// the entry as given by its field_traits
+template <class data_t>
+void read_record(AppendLogRecord const &record, data_t &data) {
+  using traits = field_traits<data_t>;
+  std::vector<hsize_t> shape;
+  size_t nbytes = sizeof(typename traits::coeff_type);
+  for (auto dim : record.shape) {
+    shape.push_back(dim < 0 ? 0 : (hsize_t)dim);
+    nbytes *= shape.back();
+  }
+  long bit_count = 0;
+  if constexpr (traits::packed)
+    if (shape.size() == 1) {
+      bit_count = (long)shape[0];
+      shape[0] = (shape[0] + 7) / 8;
+      nbytes = shape[0] * sizeof(typename traits::coeff_type);
+    }
+  bool rank_ok = (traits::rank < 0) ||
+                 (record.shape.size() == (size_t)traits::rank);
+  if (!rank_ok || (record.bytes.size() != nbytes))
+    throw std::runtime_error("Lime error: invalid record in log for field: " +
+                             record.field);
+  traits::resize(data, shape);
+  std::memcpy(traits::data(data), record.bytes.data(), record.bytes.size());
+  if constexpr (traits::packed)
+    traits::set_bit_count(data, bit_count);
+}
+
+void read_record(AppendLogRecord const &record, Record &data);
+
+} // namespace lime
+
+#endif
@@ -0,0 +1,79 @@
+// Copyright 2020 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIME_ATTRIBUTE_TRAITS_H
+#define LIME_ATTRIBUTE_TRAITS_H
+
+#include <type_traits>
+#include <vector>
+
+#include <hdf5.h>
+
+#include <lime/field_traits.h>
+
+namespace lime {
+
+// Traits of typed attribute values, i.e. scalars of the coefficient types
+// of fields (integers, floating point and complex numbers) and
+// std::vectors of them. resize provides the memory for values of given
+// dimensions, nullptr if they don't fit the value.
+template <class value_t, class = void> struct attribute_traits {
+  static constexpr bool typed = false;
+};
+
+template <class coeff_t>
+struct attribute_traits<coeff_t,
+                        std::void_t<decltype(coeff_traits<coeff_t>::name())>> {
+  static constexpr bool typed = true;
+  using coeff_type = coeff_t;
+
+  static inline std::vector<hsize_t> dims(coeff_t const &) { return {}; }
+  static inline coeff_t const *data(coeff_t const &value) { return &value; }
+  static inline void *resize(coeff_t &value,
+                             std::vector<hsize_t> const &dims) {
+    hsize_t size = 1;
+    for (auto dim : dims)
+      size *= dim;
+    return (size == 1) ? &value : nullptr;
+  }
+};
+
+template <class coeff_t>
+struct attribute_traits<std::vector<coeff_t>,
+                        std::void_t<decltype(coeff_traits<coeff_t>::name())>> {
+  static constexpr bool typed = true;
+  using coeff_type = coeff_t;
+
+  static inline std::vector<hsize_t> dims(std::vector<coeff_t> const &value) {
+    return {(hsize_t)value.size()};
+  }
+  static inline coeff_t const *data(std::vector<coeff_t> const &value) {
+    return value.data();
+  }
+  static inline void *resize(std::vector<coeff_t> &value,
+                             std::vector<hsize_t> const &dims) {
+    hsize_t size = 1;
+    for (auto dim : dims)
+      size *= dim;
+    value.resize(size);
+    return value.empty() ? (void *)&value : (void *)value.data();
+  }
+};
+
+template <class value_t>
+constexpr bool typed_attribute = attribute_traits<value_t>::typed;
+
+} // namespace lime
+
+#endif
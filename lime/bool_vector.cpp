@@ -0,0 +1,47 @@
+#include "bool_vector.h"
+
+#include <algorithm>
+
+namespace lime {
+
+BoolVector::BoolVector(size_type size, bool value)
+    : size_(size), bytes_((size + 7) / 8, value ? 0xff : 0) {
+  resize(size);
+}
+
+BoolVector::BoolVector(std::vector<bool> const &values)
+    : BoolVector((size_type)values.size()) {
+  for (size_type idx = 0; idx < size_; ++idx)
+    set(idx, values[idx]);
+}
+
+void BoolVector::resize(size_type size) {
+  // Clear bits which are no longer (or not yet) part of the vector
+  size_type nbits = std::min(size, size_);
+  if (nbits % 8 != 0)
+    bytes_[nbits / 8] &= (uint8_t)((1 << (nbits % 8)) - 1);
+  bytes_.resize((size + 7) / 8, 0);
+  size_ = size;
+}
+
+void BoolVector::clear() {
+  size_ = 0;
+  bytes_.clear();
+}
+
+BoolVector::size_type BoolVector::count() const {
+  size_type count = 0;
+  for (auto byte : bytes_)
+    count += __builtin_popcount(byte);
+  return count;
+}
+
+bool BoolVector::operator==(BoolVector const &other) const {
+  return (size_ == other.size_) && (bytes_ == other.bytes_);
+}
+
+bool BoolVector::operator!=(BoolVector const &other) const {
+  return !operator==(other);
+}
+
+} // namespace lime
@@ -0,0 +1,63 @@
+// Copyright 2020 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIME_BOOL_VECTOR_H
+#define LIME_BOOL_VECTOR_H
+
+#include <cstdint>
+#include <vector>
+
+namespace lime {
+
+// Vector of booleans packed into bytes, bit idx is stored in byte idx / 8
+// at position idx % 8 (least significant bit first). Unused bits of the
+// last byte are always zero.
+class BoolVector {
+public:
+  using size_type = int64_t;
+
+  BoolVector() = default;
+  explicit BoolVector(size_type size, bool value = false);
+  BoolVector(std::vector<bool> const &values);
+
+  inline size_type size() const { return size_; }
+  inline size_type nbytes() const { return (size_type)bytes_.size(); }
+  inline uint8_t *data() { return bytes_.data(); }
+  inline uint8_t const *data() const { return bytes_.data(); }
+
+  inline bool operator()(size_type idx) const {
+    return (bytes_[idx >> 3] >> (idx & 7)) & 1;
+  }
+  inline void set(size_type idx, bool value) {
+    if (value)
+      bytes_[idx >> 3] |= (uint8_t)(1 << (idx & 7));
+    else
+      bytes_[idx >> 3] &= (uint8_t) ~(1 << (idx & 7));
+  }
+
+  void resize(size_type size);
+  void clear();
+  size_type count() const;
+
+  bool operator==(BoolVector const &other) const;
+  bool operator!=(BoolVector const &other) const;
+
+private:
+  size_type size_ = 0;
+  std::vector<uint8_t> bytes_;
+};
+
+} // namespace lime
+
+#endif
@@ -0,0 +1,265 @@
+#include "catalog.h"
+
+#include <algorithm>
+#include <set>
+#include <stdexcept>
+
+#include <hdf5.h>
+
+#include <lime/file_h5.h>
+#include <lime/hdf5/utils.h>
+
+#define LIME_CATALOG_VERSION_STRING "LimeCatalogVersion"
+#define LIME_CATALOG_VERSION "1"
+
+namespace lime {
+
+namespace {
+
+// Rows of the entries and attributes tables of a catalog file, strings
+// are stored with variable length and files by their index
+struct StoredEntry {
+  unsigned long long file;
+  const char *field;
+  const char *type;
+  int extensible;
+  long long size;
+};
+
+struct StoredAttribute {
+  unsigned long long entry;
+  const char *name;
+  const char *value;
+};
+
+hid_t string_type() {
+  hid_t str_type_id = H5Tcopy(H5T_C_S1);
+  H5Tset_size(str_type_id, H5T_VARIABLE);
+  return str_type_id;
+}
+
+hid_t entry_type(hid_t str_type_id) {
+  hid_t type_id = H5Tcreate(H5T_COMPOUND, sizeof(StoredEntry));
+  H5Tinsert(type_id, "file", HOFFSET(StoredEntry, file), H5T_NATIVE_ULLONG);
+  H5Tinsert(type_id, "field", HOFFSET(StoredEntry, field), str_type_id);
+  H5Tinsert(type_id, "type", HOFFSET(StoredEntry, type), str_type_id);
+  H5Tinsert(type_id, "extensible", HOFFSET(StoredEntry, extensible),
+            H5T_NATIVE_INT);
+  H5Tinsert(type_id, "size", HOFFSET(StoredEntry, size), H5T_NATIVE_LLONG);
+  return type_id;
+}
+
+hid_t attribute_type(hid_t str_type_id) {
+  hid_t type_id = H5Tcreate(H5T_COMPOUND, sizeof(StoredAttribute));
+  H5Tinsert(type_id, "entry", HOFFSET(StoredAttribute, entry),
+            H5T_NATIVE_ULLONG);
+  H5Tinsert(type_id, "name", HOFFSET(StoredAttribute, name), str_type_id);
+  H5Tinsert(type_id, "value", HOFFSET(StoredAttribute, value), str_type_id);
+  return type_id;
+}
+
+template <class row_t>
+void write_table(hid_t file_id, std::string name, hid_t type_id,
+                 std::vector<row_t> const &rows) {
+  hsize_t n_rows = rows.size();
+  hid_t space_id = H5Screate_simple(1, &n_rows, NULL);
+  hid_t dataset_id = H5Dcreate2(file_id, name.c_str(), type_id, space_id,
+                                H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  herr_t status = 0;
+  if (n_rows > 0)
+    status = H5Dwrite(dataset_id, type_id, H5S_ALL, H5S_ALL, H5P_DEFAULT,
+                      rows.data());
+  H5Dclose(dataset_id);
+  H5Sclose(space_id);
+  if ((dataset_id < 0) || (status < 0)) {
+    auto msg = std::string("Lime error: can't write catalog table: ") + name;
+    throw std::runtime_error(msg);
+  }
+}
+
+// Rows of a table are passed to f, the strings they point to are freed
+// afterwards
+template <class row_t, class function_t>
+void read_table(hid_t file_id, std::string name, hid_t type_id,
+                function_t f) {
+  hid_t dataset_id = H5Dopen2(file_id, name.c_str(), H5P_DEFAULT);
+  if (dataset_id < 0) {
+    auto msg = std::string("Lime error: can't read catalog table: ") + name;
+    throw std::runtime_error(msg);
+  }
+  hid_t space_id = H5Dget_space(dataset_id);
+  hssize_t n_rows = H5Sget_simple_extent_npoints(space_id);
+  std::vector<row_t> rows(n_rows > 0 ? n_rows : 0);
+  if (!rows.empty()) {
+    H5Dread(dataset_id, type_id, H5S_ALL, H5S_ALL, H5P_DEFAULT, rows.data());
+    for (auto const &row : rows)
+      f(row);
+#if H5_VERSION_GE(1, 12, 0)
+    H5Treclaim(type_id, space_id, H5P_DEFAULT, rows.data());
+#else
+    H5Dvlen_reclaim(type_id, space_id, H5P_DEFAULT, rows.data());
+#endif
+  }
+  H5Sclose(space_id);
+  H5Dclose(dataset_id);
+}
+
+bool lime_attribute(std::string const &attribute_name) {
+  return attribute_name.compare(0, 9, "LimeField") == 0;
+}
+
+} // namespace
+
+Catalog::Catalog(std::string filename) {
+  hid_t file_id;
+  H5E_BEGIN_TRY {
+    file_id = H5Fopen(filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+  }
+  H5E_END_TRY;
+  if ((file_id < 0) ||
+      (H5Aexists(file_id, LIME_CATALOG_VERSION_STRING) <= 0) ||
+      (hdf5::get_attribute_value(file_id, LIME_CATALOG_VERSION_STRING) !=
+       LIME_CATALOG_VERSION)) {
+    if (file_id >= 0)
+      H5Fclose(file_id);
+    auto msg = std::string("Lime error: not a lime catalog: ") + filename;
+    throw std::runtime_error(msg);
+  }
+
+  hid_t str_type_id = string_type();
+  std::vector<std::string> filenames;
+  read_table<const char *>(file_id, "files", str_type_id,
+                           [&filenames](const char *filename) {
+                             filenames.push_back(filename);
+                           });
+  hid_t entry_type_id = entry_type(str_type_id);
+  read_table<StoredEntry>(
+      file_id, "entries", entry_type_id, [&](StoredEntry const &row) {
+        entries_.push_back({filenames.at(row.file), row.field, row.type,
+                            row.extensible != 0, (long)row.size, {}});
+      });
+  hid_t attribute_type_id = attribute_type(str_type_id);
+  read_table<StoredAttribute>(
+      file_id, "attributes", attribute_type_id,
+      [this](StoredAttribute const &row) {
+        entries_.at(row.entry).attributes[row.name] = row.value;
+      });
+  H5Tclose(attribute_type_id);
+  H5Tclose(entry_type_id);
+  H5Tclose(str_type_id);
+  H5Fclose(file_id);
+  index();
+}
+
+void Catalog::add(std::string filename) {
+  remove(filename);
+  auto file = FileH5(filename, "r");
+  for (auto const &field : file.fields()) {
+    CatalogEntry entry{filename, field, "", false, 0, {}};
+    for (auto const &attribute : file.attributes(field))
+      if (!lime_attribute(attribute.first))
+        entry.attributes.insert(attribute);
+    entry.type = file.type(field);
+    entry.extensible = file.extensible(field);
+    entry.size = file.size(field);
+    entries_.push_back(entry);
+  }
+  file.close();
+  index();
+}
+
+void Catalog::remove(std::string filename) {
+  entries_.erase(std::remove_if(entries_.begin(), entries_.end(),
+                                [&filename](CatalogEntry const &entry) {
+                                  return entry.filename == filename;
+                                }),
+                 entries_.end());
+  index();
+}
+
+void Catalog::write(std::string filename) const {
+  hid_t file_id =
+      H5Fcreate(filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+  if (file_id < 0) {
+    auto msg = std::string("Lime error: can't create catalog: ") + filename;
+    throw std::runtime_error(msg);
+  }
+
+  // Tables point to the strings of the entries
+  std::vector<const char *> files;
+  std::map<std::string, unsigned long long> file_indices;
+  std::vector<StoredEntry> stored_entries;
+  std::vector<StoredAttribute> stored_attributes;
+  for (auto const &entry : entries_) {
+    auto file = file_indices.find(entry.filename);
+    if (file == file_indices.end()) {
+      file = file_indices.emplace(entry.filename, files.size()).first;
+      files.push_back(entry.filename.c_str());
+    }
+    for (auto const &attribute : entry.attributes)
+      stored_attributes.push_back({stored_entries.size(),
+                                   attribute.first.c_str(),
+                                   attribute.second.c_str()});
+    stored_entries.push_back({file->second, entry.field.c_str(),
+                              entry.type.c_str(), entry.extensible ? 1 : 0,
+                              (long long)entry.size});
+  }
+
+  hid_t str_type_id = string_type();
+  hid_t entry_type_id = entry_type(str_type_id);
+  hid_t attribute_type_id = attribute_type(str_type_id);
+  try {
+    write_table(file_id, "files", str_type_id, files);
+    write_table(file_id, "entries", entry_type_id, stored_entries);
+    write_table(file_id, "attributes", attribute_type_id, stored_attributes);
+    hdf5::set_attribute_value(file_id, LIME_CATALOG_VERSION_STRING,
+                              LIME_CATALOG_VERSION);
+  } catch (...) {
+    H5Tclose(attribute_type_id);
+    H5Tclose(entry_type_id);
+    H5Tclose(str_type_id);
+    H5Fclose(file_id);
+    throw;
+  }
+  H5Tclose(attribute_type_id);
+  H5Tclose(entry_type_id);
+  H5Tclose(str_type_id);
+  H5Fclose(file_id);
+}
+
+std::vector<std::string> Catalog::filenames() const {
+  std::vector<std::string> filenames;
+  std::set<std::string> found;
+  for (auto const &entry : entries_)
+    if (found.insert(entry.filename).second)
+      filenames.push_back(entry.filename);
+  return filenames;
+}
+
+std::vector<CatalogEntry> Catalog::select(AttributeQuery const &query) const {
+  std::vector<CatalogEntry> selected;
+  auto indices = field_entries_.find(query.field());
+  if (indices != field_entries_.end())
+    for (auto idx : indices->second)
+      if (query.matches(entries_[idx].attributes))
+        selected.push_back(entries_[idx]);
+  return selected;
+}
+
+std::vector<std::string>
+Catalog::filenames(AttributeQuery const &query) const {
+  std::vector<std::string> filenames;
+  std::set<std::string> found;
+  for (auto const &entry : select(query))
+    if (found.insert(entry.filename).second)
+      filenames.push_back(entry.filename);
+  return filenames;
+}
+
+void Catalog::index() {
+  field_entries_.clear();
+  for (size_t idx = 0; idx < entries_.size(); ++idx)
+    field_entries_[entries_[idx].field].push_back(idx);
+}
+
+} // namespace lime
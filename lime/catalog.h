@@ -0,0 +1,75 @@
+// Copyright 2020 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIME_CATALOG_H
+#define LIME_CATALOG_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <lime/query.h>
+
+namespace lime {
+
+// Metadata of a field of a lime file, as stored in a catalog. Only the
+// attributes of the user are kept, lime's own attributes (LimeField...)
+// are given by type, extensible and size.
+struct CatalogEntry {
+  std::string filename;
+  std::string field;
+  std::string type;
+  bool extensible;
+  long size;
+  std::map<std::string, std::string> attributes;
+};
+
+// Index of the fields of many lime files, scanned once and stored in a
+// single hdf5 file. Queries on the attributes of fields are answered from
+// the catalog without opening the lime files.
+//
+//   Catalog catalog;
+//   for (auto filename : filenames)
+//     catalog.add(filename);
+//   catalog.write("catalog.h5");
+//   ...
+//   auto files = Catalog("catalog.h5").filenames(
+//       AttributeQuery("energy").equals("L", 16));
+class Catalog {
+public:
+  Catalog() = default;
+  explicit Catalog(std::string filename); // read a catalog file
+
+  // Scan the fields of a lime file, replaces earlier entries of the file
+  void add(std::string filename);
+  void remove(std::string filename);
+  void write(std::string filename) const;
+
+  inline std::vector<CatalogEntry> const &entries() const { return entries_; }
+  std::vector<std::string> filenames() const;
+
+  // Entries of the queried field matching its conditions, and the files
+  // holding them in the order they were added
+  std::vector<CatalogEntry> select(AttributeQuery const &query) const;
+  std::vector<std::string> filenames(AttributeQuery const &query) const;
+
+private:
+  void index();
+  std::vector<CatalogEntry> entries_;
+  std::map<std::string, std::vector<size_t>> field_entries_;
+};
+
+} // namespace lime
+
+#endif
@@ -0,0 +1,54 @@
+// Copyright 2020 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIME_CHUNK_CACHE_H
+#define LIME_CHUNK_CACHE_H
+
+#include <cstddef>
+
+// Bounds of automatically sized chunk caches and number of datasets with
+// a chunk cache kept open by a FileH5
+#ifndef LIME_CHUNK_CACHE_MIN_BYTES
+#define LIME_CHUNK_CACHE_MIN_BYTES (1 << 20)
+#endif
+#ifndef LIME_CHUNK_CACHE_MAX_BYTES
+#define LIME_CHUNK_CACHE_MAX_BYTES (64 << 20)
+#endif
+#ifndef LIME_MAX_OPEN_DATASETS
+#define LIME_MAX_OPEN_DATASETS 64
+#endif
+
+namespace lime {
+
+// Raw data chunk cache of a field (see H5Pset_chunk_cache). By default the
+// cache is sized from the chunks of the field and its access pattern:
+// appended fields cache the last chunk and preempt fully written chunks
+// first, randomly read fields cache several chunks. Values which are set
+// override the automatic choice.
+struct ChunkCache {
+  enum Access { Default, Append, RandomRead };
+
+  Access access = Default; // Default: Append in write modes, else RandomRead
+  size_t nbytes = 0;       // size of the cache in bytes, 0: automatic
+  size_t nslots = 0;       // number of hash table slots, 0: automatic
+  double w0 = -1.;         // preemption policy in [0, 1], negative: automatic
+
+  ChunkCache() = default;
+  ChunkCache(Access access, size_t nbytes = 0)
+      : access(access), nbytes(nbytes) {}
+};
+
+} // namespace lime
+
+#endif
@@ -0,0 +1,64 @@
+// Copyright 2020 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIME_FIELD_STORAGE_H
+#define LIME_FIELD_STORAGE_H
+
+#include <stdexcept>
+#include <string>
+
+namespace lime {
+
+// Storage of the coefficients of a field on disk. Floating point fields can
+// be stored with reduced precision and/or as integers scaled to a number of
+// decimal digits (hdf5 scale-offset filter), hdf5 converts the coefficients
+// while writing and reading.
+struct FieldStorage {
+  enum Precision { Native, Float32, Float16 };
+
+  Precision precision = Native;
+  int scale_digits = -1; // negative: no scaling
+
+  FieldStorage() = default;
+  FieldStorage(Precision precision, int scale_digits = -1)
+      : precision(precision), scale_digits(scale_digits) {}
+};
+
+inline std::string precision_string(FieldStorage::Precision precision) {
+  switch (precision) {
+  case FieldStorage::Float32:
+    return "Float32";
+  case FieldStorage::Float16:
+    return "Float16";
+  default:
+    return "Native";
+  }
+}
+
+inline FieldStorage::Precision precision_from_string(std::string precision) {
+  if (precision == "Native")
+    return FieldStorage::Native;
+  else if (precision == "Float32")
+    return FieldStorage::Float32;
+  else if (precision == "Float16")
+    return FieldStorage::Float16;
+  else {
+    auto msg = std::string("Lime error: invalid storage type: ") + precision;
+    throw std::runtime_error(msg);
+  }
+}
+
+} // namespace lime
+
+#endif
@@ -0,0 +1,371 @@
+// Copyright 2020 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIME_FIELD_TRAITS_H
+#define LIME_FIELD_TRAITS_H
+
+#include <algorithm>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#if __cplusplus >= 202002L
+#include <span>
+#endif
+
+#include <hdf5.h>
+#include <lila/all.h>
+
+#include <lime/bool_vector.h>
+#include <lime/record.h>
+#include <lime/tensor.h>
+#include <lime/view.h>
+#include <lime/hdf5/types.h>
+#include <lime/types.h>
+
+namespace lime {
+
+// Traits of the coefficients (element type) of a field
+template <class coeff_t> struct coeff_traits;
+
+template <> struct coeff_traits<int> {
+  static std::string name() { return "Int"; }
+};
+template <> struct coeff_traits<unsigned> {
+  static std::string name() { return "Uint"; }
+};
+template <> struct coeff_traits<long> {
+  static std::string name() { return "Long"; }
+};
+template <> struct coeff_traits<unsigned long> {
+  static std::string name() { return "Ulong"; }
+};
+template <> struct coeff_traits<long long> {
+  static std::string name() { return "Llong"; }
+};
+template <> struct coeff_traits<unsigned long long> {
+  static std::string name() { return "Ullong"; }
+};
+template <> struct coeff_traits<sscalar> {
+  static std::string name() { return "Float"; }
+};
+template <> struct coeff_traits<dscalar> {
+  static std::string name() { return "Double"; }
+};
+template <> struct coeff_traits<cscalar> {
+  static std::string name() { return "ComplexFloat"; }
+};
+template <> struct coeff_traits<zscalar> {
+  static std::string name() { return "ComplexDouble"; }
+};
+
+// Traits of a field entry, i.e. its coefficient type and rank. The shape
+// of an entry is given in the order of its indices, column_major entries
+// are stored with reversed dimensions. Entries of arbitrary rank have rank
+// -1, their rank is given by the dimensions of the field. Packed entries
+// store several values per coefficient, their number of values is kept in
+// an attribute of the field. Entries are only resized if their shape
+// changes, such that their memory is reused when read repeatedly. Scalars
+// use the primary template.
+template <class data_t> struct field_traits {
+  using coeff_type = data_t;
+  static constexpr int rank = 0;
+  static constexpr bool column_major = false;
+  static constexpr bool packed = false;
+  static std::string name() {
+    return coeff_traits<data_t>::name() + "Scalar";
+  }
+
+  static inline std::vector<hsize_t> shape(data_t const &) { return {}; }
+  static inline void resize(data_t &, std::vector<hsize_t> const &) {}
+  static inline coeff_type *data(data_t &data) { return &data; }
+  static inline coeff_type const *data(data_t const &data) { return &data; }
+};
+
+template <class coeff_t> struct field_traits<lila::Vector<coeff_t>> {
+  using coeff_type = coeff_t;
+  static constexpr int rank = 1;
+  static constexpr bool column_major = false;
+  static constexpr bool packed = false;
+  static std::string name() {
+    return coeff_traits<coeff_t>::name() + "Vector";
+  }
+
+  static inline std::vector<hsize_t> shape(lila::Vector<coeff_t> const &vec) {
+    return {(hsize_t)vec.size()};
+  }
+  static inline void resize(lila::Vector<coeff_t> &vec,
+                            std::vector<hsize_t> const &shape) {
+    if ((hsize_t)vec.size() != shape[0])
+      vec.resize(shape[0]);
+  }
+  static inline coeff_t *data(lila::Vector<coeff_t> &vec) {
+    return vec.data();
+  }
+  static inline coeff_t const *data(lila::Vector<coeff_t> const &vec) {
+    return vec.data();
+  }
+};
+
+template <class coeff_t> struct field_traits<lila::Matrix<coeff_t>> {
+  using coeff_type = coeff_t;
+  static constexpr int rank = 2;
+  static constexpr bool column_major = true;
+  static constexpr bool packed = false;
+  static std::string name() {
+    return coeff_traits<coeff_t>::name() + "Matrix";
+  }
+
+  static inline std::vector<hsize_t> shape(lila::Matrix<coeff_t> const &mat) {
+    return {(hsize_t)mat.nrows(), (hsize_t)mat.ncols()};
+  }
+  static inline void resize(lila::Matrix<coeff_t> &mat,
+                            std::vector<hsize_t> const &shape) {
+    if (((hsize_t)mat.nrows() != shape[0]) ||
+        ((hsize_t)mat.ncols() != shape[1]))
+      mat.resize(shape[0], shape[1]);
+  }
+  static inline coeff_t *data(lila::Matrix<coeff_t> &mat) {
+    return mat.data();
+  }
+  static inline coeff_t const *data(lila::Matrix<coeff_t> const &mat) {
+    return mat.data();
+  }
+};
+
+template <class coeff_t> struct field_traits<Tensor<coeff_t>> {
+  using coeff_type = coeff_t;
+  static constexpr int rank = -1;
+  static constexpr bool column_major = false;
+  static constexpr bool packed = false;
+  static std::string name() {
+    return coeff_traits<coeff_t>::name() + "Tensor";
+  }
+
+  static inline std::vector<hsize_t> shape(Tensor<coeff_t> const &tensor) {
+    return std::vector<hsize_t>(tensor.shape().begin(), tensor.shape().end());
+  }
+  static inline void resize(Tensor<coeff_t> &tensor,
+                            std::vector<hsize_t> const &shape) {
+    if (!std::equal(shape.begin(), shape.end(), tensor.shape().begin(),
+                    tensor.shape().end()))
+      tensor.resize(std::vector<int64_t>(shape.begin(), shape.end()));
+  }
+  static inline coeff_t *data(Tensor<coeff_t> &tensor) {
+    return tensor.data();
+  }
+  static inline coeff_t const *data(Tensor<coeff_t> const &tensor) {
+    return tensor.data();
+  }
+};
+
+// BoolVectors are stored as bytes holding eight values each
+template <> struct field_traits<BoolVector> {
+  using coeff_type = unsigned char;
+  static constexpr int rank = 1;
+  static constexpr bool column_major = false;
+  static constexpr bool packed = true;
+  static std::string name() { return "BoolVector"; }
+
+  static inline std::vector<hsize_t> shape(BoolVector const &vec) {
+    return {(hsize_t)vec.nbytes()};
+  }
+  static inline void resize(BoolVector &vec,
+                            std::vector<hsize_t> const &shape) {
+    vec.resize(8 * shape[0]);
+  }
+  static inline coeff_type *data(BoolVector &vec) { return vec.data(); }
+  static inline coeff_type const *data(BoolVector const &vec) {
+    return vec.data();
+  }
+
+  static inline long bit_count(BoolVector const &vec) { return vec.size(); }
+  static inline void set_bit_count(BoolVector &vec, long bit_count) {
+    vec.resize(bit_count);
+  }
+};
+
+// Records are stored by dedicated overloads of FileH5, since their datatype
+// depends on their members. The traits only provide their type string.
+template <> struct field_traits<Record> {
+  using coeff_type = char;
+  static constexpr int rank = 0;
+  static constexpr bool column_major = false;
+  static constexpr bool packed = false;
+  static std::string name() { return "Record"; }
+
+  static inline std::vector<hsize_t> shape(Record const &) { return {}; }
+  static inline void resize(Record &, std::vector<hsize_t> const &) {}
+  static inline char *data(Record &record) { return record.data(); }
+  static inline char const *data(Record const &record) {
+    return record.data();
+  }
+};
+
+// Views of caller memory are written like their owning counterparts, they
+// have the same type string but can't be read into
+template <class coeff_t> struct field_traits<VectorView<coeff_t>> {
+  using coeff_type = coeff_t;
+  static constexpr int rank = 1;
+  static constexpr bool column_major = false;
+  static constexpr bool packed = false;
+  static std::string name() {
+    return field_traits<lila::Vector<coeff_t>>::name();
+  }
+
+  static inline std::vector<hsize_t> shape(VectorView<coeff_t> const &vec) {
+    return {(hsize_t)vec.size()};
+  }
+  static inline coeff_t const *data(VectorView<coeff_t> const &vec) {
+    return vec.data();
+  }
+};
+
+template <class coeff_t> struct field_traits<MatrixView<coeff_t>> {
+  using coeff_type = coeff_t;
+  static constexpr int rank = 2;
+  static constexpr bool column_major = true;
+  static constexpr bool packed = false;
+  static std::string name() {
+    return field_traits<lila::Matrix<coeff_t>>::name();
+  }
+
+  static inline std::vector<hsize_t> shape(MatrixView<coeff_t> const &mat) {
+    return {(hsize_t)mat.nrows(), (hsize_t)mat.ncols()};
+  }
+  static inline coeff_t const *data(MatrixView<coeff_t> const &mat) {
+    return mat.data();
+  }
+};
+
+template <class coeff_t> struct field_traits<TensorView<coeff_t>> {
+  using coeff_type = coeff_t;
+  static constexpr int rank = -1;
+  static constexpr bool column_major = false;
+  static constexpr bool packed = false;
+  static std::string name() { return field_traits<Tensor<coeff_t>>::name(); }
+
+  static inline std::vector<hsize_t> shape(TensorView<coeff_t> const &tensor) {
+    return std::vector<hsize_t>(tensor.shape().begin(), tensor.shape().end());
+  }
+  static inline coeff_t const *data(TensorView<coeff_t> const &tensor) {
+    return tensor.data();
+  }
+};
+
+#ifdef __cpp_lib_span
+template <class coeff_t, std::size_t extent>
+struct field_traits<std::span<coeff_t, extent>>
+    : field_traits<VectorView<std::remove_const_t<coeff_t>>> {
+  static inline std::vector<hsize_t> shape(std::span<coeff_t, extent> vec) {
+    return {(hsize_t)vec.size()};
+  }
+  static inline coeff_t const *data(std::span<coeff_t, extent> vec) {
+    return vec.data();
+  }
+};
+#endif
+
+// Owning field type of an entry, i.e. the type views are collected as
+template <class data_t> struct owner_of { using type = data_t; };
+template <class coeff_t> struct owner_of<VectorView<coeff_t>> {
+  using type = lila::Vector<coeff_t>;
+};
+template <class coeff_t> struct owner_of<MatrixView<coeff_t>> {
+  using type = lila::Matrix<coeff_t>;
+};
+template <class coeff_t> struct owner_of<TensorView<coeff_t>> {
+  using type = Tensor<coeff_t>;
+};
+#ifdef __cpp_lib_span
+template <class coeff_t, std::size_t extent>
+struct owner_of<std::span<coeff_t, extent>> {
+  using type = lila::Vector<std::remove_const_t<coeff_t>>;
+};
+#endif
+
+// Copy of an entry as its owning field type
+template <class data_t>
+inline typename owner_of<data_t>::type make_owner(data_t const &data) {
+  using owner_t = typename owner_of<data_t>::type;
+  auto shape = field_traits<data_t>::shape(data);
+  hsize_t size = 1;
+  for (auto dim : shape)
+    size *= dim;
+  owner_t owner;
+  field_traits<owner_t>::resize(owner, shape);
+  std::copy(field_traits<data_t>::data(data),
+            field_traits<data_t>::data(data) + size,
+            field_traits<owner_t>::data(owner));
+  return owner;
+}
+
+template <class data_t> inline hid_t field_datatype() {
+  return hdf5::hdf5_datatype<typename field_traits<data_t>::coeff_type>();
+}
+
+template <class data_t> inline std::string const &field_type_string() {
+  static const std::string type = field_traits<data_t>::name();
+  return type;
+}
+
+// Size of the coefficients of an entry in bytes
+template <class data_t> inline size_t entry_bytes(data_t const &data) {
+  using traits = field_traits<data_t>;
+  size_t bytes = sizeof(typename traits::coeff_type);
+  for (auto dim : traits::shape(data))
+    bytes *= dim;
+  return bytes;
+}
+inline size_t entry_bytes(Record const &record) { return record.nbytes(); }
+
+// Entry types of fields which can be read from files and collected in
+// Measurements, new field types only need to be added here
+using lime_field_types =
+    std::tuple<int, unsigned, long, unsigned long, long long,
+               unsigned long long, sscalar, dscalar, cscalar, zscalar,
+               svector, dvector, cvector, zvector, smatrix, dmatrix, cmatrix,
+               zmatrix, ivector, uvector, lvector, ulvector, llvector,
+               ullvector, imatrix, umatrix, lmatrix, ulmatrix, llmatrix,
+               ullmatrix, bvector, itensor, utensor, ltensor, ultensor,
+               lltensor, ulltensor, stensor, dtensor, ctensor, ztensor,
+               Record>;
+
+template <class data_t> struct type_tag { using type = data_t; };
+
+template <class F, class... data_t>
+inline bool dispatch_field_type(std::string const &type, F &&f,
+                                std::tuple<data_t...> const *) {
+  return ((type == field_type_string<data_t>()
+               ? (f(type_tag<data_t>()), true)
+               : false) ||
+          ...);
+}
+
+// Calls f(type_tag<data_t>()) for the field type data_t with the given type
+// string, returns false if the type string is not a lime field type
+template <class F>
+inline bool dispatch_field_type(std::string const &type, F &&f) {
+  return dispatch_field_type(type, f, (lime_field_types const *)nullptr);
+}
+
+template <class... data_t>
+inline std::vector<std::string>
+field_type_strings(std::tuple<data_t...> const *) {
+  return {field_type_string<data_t>()...};
+}
+
+} // namespace lime
+
+#endif
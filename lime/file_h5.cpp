@@ -1,74 +1,193 @@
 #include "file_h5.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <iostream>
+#include <set>
 #include <stdexcept>
 
-#include <lime/type_string.h>
-
 #include <lime/hdf5/types.h>
 #include <lime/hdf5/utils.h>
 
-#include <lime/hdf5/create_static_field.h>
-#include <lime/hdf5/read_static_compatible.h>
-#include <lime/hdf5/read_static_field.h>
-#include <lime/hdf5/write_compatible.h>
-#include <lime/hdf5/write_static_field.h>
+namespace lime {
 
-#include <lime/hdf5/append_compatible.h>
-#include <lime/hdf5/append_extensible_field.h>
-#include <lime/hdf5/create_extensible_field.h>
-#include <lime/hdf5/read_extensible_compatible.h>
-#include <lime/hdf5/read_extensible_field.h>
+namespace {
+
+// Record with the members of a record field
+Record record_layout(hid_t file_id, std::string field,
+                     std::string const &member_types) {
+  hid_t dataset_id = hdf5::open_dataset(file_id, field);
+  hid_t datatype_id = H5Dget_type(dataset_id);
+  Record record = Record::from_datatype(datatype_id, member_types);
+  H5Tclose(datatype_id);
+  H5Dclose(dataset_id);
+  return record;
+}
 
-namespace lime {
+void check_record_field(FileH5 const &file, std::string field,
+                        bool extensible) {
+  if (!file.defined(field)) {
+    auto msg = std::string("Lime error: field not found while "
+                           "trying to read: ") +
+               field;
+    throw std::runtime_error(msg);
+  }
+  if (file.type(field) != "Record") {
+    auto msg = std::string("Lime error: wrong field type in read");
+    throw std::runtime_error(msg);
+  }
+  if (file.extensible(field) != extensible) {
+    auto msg = std::string("Lime error: wrong extensibility of record "
+                           "field in read: ") +
+               field;
+    throw std::runtime_error(msg);
+  }
+}
+
+// Attributes lime keeps about its fields
+bool lime_attribute(std::string const &attribute_name) {
+  return attribute_name.compare(0, 9, "LimeField") == 0;
+}
+
+} // namespace
 
 FileH5::operator bool() const { return file_id_ != hid_t(); }
 
-FileH5::FileH5(std::string filename, std::string iomode)
-    : filename_(filename), iomode_(iomode) {
-  // Open file in read-only mode
-  if (iomode == "r") {
-    file_id_ = H5Fopen(filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
-    hdf5::H5OvisitCompatible(file_id_, H5_INDEX_NAME, H5_ITER_NATIVE,
-                             &lime::hdf5::parse_file, this);
+FileH5::FileH5(std::string filename, std::string iomode, std::string group)
+    : FileH5(filename, iomode, FileH5Options(), group) {}
 
-    if (file_id_ < 0) {
-      auto msg = std::string("Lime error: can't open file (r): ") + filename;
-      throw std::runtime_error(msg);
-    }
+FileH5::FileH5(std::string filename, std::string iomode,
+               FileH5Options const &options, std::string group)
+    : filename_(filename), iomode_(iomode), group_(group), options_(options) {
+  if ((iomode != "r") && (iomode != "w!") && (iomode != "w") &&
+      (iomode != "a"))
+    throw std::runtime_error("Lime error: invalid iomode for FileH5!");
+
+  hid_t create_id = hdf5::file_create_plist(options);
+  hid_t access_id = hdf5::file_access_plist(options);
+  if ((create_id < 0) || (access_id < 0)) {
+    if (create_id >= 0)
+      H5Pclose(create_id);
+    if (access_id >= 0)
+      H5Pclose(access_id);
+    auto msg = std::string("Lime error: invalid FileH5Options for file: ") +
+               filename;
+    throw std::runtime_error(msg);
   }
+
+  // Open file in read-only mode
+  if (iomode == "r")
+    file_id_ = H5Fopen(filename.c_str(), H5F_ACC_RDONLY, access_id);
   // Open file in forced write mode
-  else if (iomode == "w!") {
-    file_id_ =
-        H5Fcreate(filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
-    if (file_id_ < 0) {
-      auto msg = std::string("Lime error: can't open file (w!): ") + filename;
-      throw std::runtime_error(msg);
+  else if (iomode == "w!")
+    file_id_ = H5Fcreate(filename.c_str(), H5F_ACC_TRUNC, create_id, access_id);
+  // Open file in secure write mode
+  else if (iomode == "w")
+    file_id_ = H5Fcreate(filename.c_str(), H5F_ACC_EXCL, create_id, access_id);
+  // Open file in append mode
+  else
+    file_id_ = H5Fopen(filename.c_str(), H5F_ACC_RDWR, access_id);
+  H5Pclose(create_id);
+  H5Pclose(access_id);
+  if (file_id_ < 0) {
+    auto msg = std::string("Lime error: can't open file (") + iomode +
+               "): " + filename;
+    throw std::runtime_error(msg);
+  }
+
+  open_fields();
+}
+
+FileH5 FileH5::from_image(std::vector<char> const &image, std::string iomode,
+                          std::string group) {
+  if ((iomode != "r") && (iomode != "a"))
+    throw std::runtime_error("Lime error: file images can only be opened "
+                             "with iomode r or a");
+
+  // Every image is a distinct in-memory file for hdf5
+  static std::atomic<long> n_images(0);
+  FileH5 file;
+  file.filename_ = std::string("lime_image_") + std::to_string(n_images++);
+  file.iomode_ = iomode;
+  file.group_ = group;
+  file.options_.in_memory = true;
+  file.options_.backing_store = false;
+  file.options_.memory_increment =
+      std::max(image.size(), file.options_.memory_increment);
+
+  hid_t access_id = hdf5::file_access_plist(file.options_);
+  herr_t status = H5Pset_file_image(access_id, (void *)image.data(),
+                                    image.size());
+  file.file_id_ = H5I_INVALID_HID;
+  if (status >= 0)
+    H5E_BEGIN_TRY {
+      file.file_id_ = H5Fopen(file.filename_.c_str(),
+                              (iomode == "r") ? H5F_ACC_RDONLY : H5F_ACC_RDWR,
+                              access_id);
     }
+    H5E_END_TRY;
+  H5Pclose(access_id);
+  if (file.file_id_ < 0)
+    throw std::runtime_error("Lime error: can't open file image");
+  file.open_fields();
+  return file;
+}
+
+std::vector<char> FileH5::image() const {
+  // Files opened on a group hold the file itself separately
+  hid_t file_id = (group_file_id_ >= 0) ? group_file_id_ : file_id_;
+  std::vector<char> image;
+  H5Fflush(file_id, H5F_SCOPE_LOCAL);
+  ssize_t size = H5Fget_file_image(file_id, NULL, 0);
+  if (size > 0) {
+    image.resize(size);
+    size = H5Fget_file_image(file_id, image.data(), image.size());
   }
-  // Open file in secure write mode
-  else if (iomode == "w") {
-    file_id_ =
-        H5Fcreate(filename.c_str(), H5F_ACC_EXCL, H5P_DEFAULT, H5P_DEFAULT);
+  if (size < 0) {
+    auto msg = std::string("Lime error: can't get image of file: ") +
+               filename_;
+    throw std::runtime_error(msg);
+  }
+  return image;
+}
+
+void FileH5::open_fields() {
+  // Fields are located in the group, which is created in write modes
+  if (!group_.empty()) {
+    group_file_id_ = file_id_;
+    file_id_ = hdf5::open_group(group_file_id_, group_, iomode_ != "r");
     if (file_id_ < 0) {
-      auto msg = std::string("Lime error: can't open file (w): ") + filename;
+      H5Fclose(group_file_id_);
+      auto msg = std::string("Lime error: can't open group ") + group_ +
+                 " of file: " + filename_;
       throw std::runtime_error(msg);
     }
   }
-  // Open file in append mode
-  else if (iomode == "a") {
-    file_id_ = H5Fopen(filename.c_str(), H5F_ACC_RDWR, H5P_DEFAULT);
+
+  // Only the fields below the group are parsed
+  if ((iomode_ == "r") || (iomode_ == "a"))
     hdf5::H5OvisitCompatible(file_id_, H5_INDEX_NAME, H5_ITER_NATIVE,
                              &lime::hdf5::parse_file, this);
+}
 
-    if (file_id_ < 0) {
-      auto msg = std::string("Lime error: can't open file (a): ") + filename;
-      throw std::runtime_error(msg);
-    }
-  } else
-    throw std::runtime_error("Lime error: invalid iomode for FileH5!");
+std::vector<std::string> FileH5::fields(std::string group) const {
+  if (!group.empty() && (group.back() != '/'))
+    group += "/";
+  std::vector<std::string> fields;
+  for (auto const &field : fields_)
+    if (field.compare(0, group.size(), group) == 0)
+      fields.push_back(field);
+  return fields;
+}
+
+std::vector<std::string> FileH5::groups() const {
+  std::set<std::string> groups;
+  for (auto const &field : fields_)
+    for (size_t pos = field.find('/'); pos != std::string::npos;
+         pos = field.find('/', pos + 1))
+      groups.insert(field.substr(0, pos));
+  return std::vector<std::string>(groups.begin(), groups.end());
 }
 
 std::string FileH5::type(std::string field) const {
@@ -83,178 +202,48 @@ bool FileH5::extensible(std::string field) const {
   return field_extensible_.at(field);
 }
 
-template <class data_t>
-void FileH5::read(std::string field, data_t &data) const {
-  // Read a field into data
-  if (defined(field)) {
-    // check if field datatype agrees with data
-    if (attribute(field, LIME_FIELD_TYPE_STRING) != type_string(data)) {
-      auto msg = std::string("Lime error: wrong field type in read");
-      throw std::runtime_error(msg);
-    }
-
-    // check if field extensibility is static
-    if (attribute(field, LIME_FIELD_STATIC_EXTENSIBLE_STRING) != "Static") {
-      auto msg = std::string("Lime error: trying to read a static "
-                             "field from non-static dataset");
-      throw std::runtime_error(msg);
-    }
-
-    // Check if low level dimensions are OK
-    if (lime::hdf5::read_static_compatible(file_id_, field, data))
-      lime::hdf5::read_static_field(file_id_, field, data);
-    else {
-      auto msg = std::string("Lime error: cannot read static field! "
-                             "Wrong type/shape of field: ") +
-                 field;
-      throw std::runtime_error(msg);
-    }
-  }
-  // Throw error "Field not found"
-  else {
-    auto msg = std::string("Lime error: field not found while "
-                           "trying to read: ") +
-               field;
-    throw std::runtime_error(msg);
-  }
+bool FileH5::appendable(std::string const &field) const {
+  hid_t dataset_id = hdf5::open_dataset(file_id_, field);
+  auto max_dims = hdf5::get_dataspace_max_dims(dataset_id);
+  H5Dclose(dataset_id);
+  return (max_dims.size() > 0) && (max_dims[0] == H5S_UNLIMITED);
 }
 
-template <class data_t>
-void FileH5::read(std::string field, std::vector<data_t> &data) const {
-  // Read a field into data
-  if (defined(field)) {
-    // check if field datatype agrees with data
-    if (attribute(field, LIME_FIELD_TYPE_STRING) != type_string(data)) {
-      auto msg = std::string("Lime error: wrong field type in read");
-      throw std::runtime_error(msg);
-    }
-
-    // check if is extensible
-    if (attribute(field, LIME_FIELD_STATIC_EXTENSIBLE_STRING) != "Extensible") {
-      auto msg = std::string("Lime error: trying to read an "
-                             "extensible field from non-extensible "
-                             "dataset");
-      throw std::runtime_error(msg);
-    }
-
-    // Check if low level dimensions are OK
-    if (lime::hdf5::read_extensible_compatible(file_id_, field, data))
-      lime::hdf5::read_extensible_field(file_id_, field, data);
-    else {
-      auto msg = std::string("Lime error: cannot read extensible "
-                             "field! Wrong type/shape of field: ") +
-                 field;
-      throw std::runtime_error(msg);
-    }
-  }
-  // Throw error "Field not found"
-  else {
+long FileH5::size(std::string field) const {
+  if (!defined(field)) {
     auto msg = std::string("Lime error: field not found while "
-                           "trying to read: ") +
+                           "trying to get size: ") +
                field;
     throw std::runtime_error(msg);
   }
-}
-
-template <class data_t>
-void FileH5::write(std::string field, data_t const &data, bool force) {
-  if (iomode_ == "r") {
-    throw std::runtime_error("Lime error: cannot write in read mode");
-  } else {
-    // Try to write to existing field
-    if (defined(field)) {
-      // Write to existing field if possible
-      if (force) {
-        // Throw error if field is extensible
-        if (extensible(field)) {
-          auto msg = std::string("Lime error: can't write to "
-                                 "extensible field. "
-                                 "Must be appended");
-          throw std::runtime_error(msg);
-        }
-
-        // Write to field if type/shape agree
-        if (lime::hdf5::write_compatible(file_id_, field, data))
-          lime::hdf5::write_static_field(file_id_, field, data);
-
-        // Type/shape don't agree -> throw error
-        else {
-          auto msg = std::string("Lime error: can't write to "
-                                 "field. Incompatible type/shape");
-          throw std::runtime_error(msg);
-        }
-      }
-
-      // Throw error if field already defined
-      else {
-        auto msg = std::string("Lime error: can't write to already "
-                               "existing field. Use parameter "
-                               "force=true to overwrite");
-        throw std::runtime_error(msg);
-      }
-    }
-    // Create new field and write
-    else {
-      fields_.push_back(field);
-      std::string field_type = type_string(data);
-      field_types_[field] = field_type;
-      field_extensible_[field] = false;
-      lime::hdf5::create_static_field(file_id_, field, data);
-      set_attribute(field, LIME_FIELD_TYPE_STRING, field_type);
-      set_attribute(field, LIME_FIELD_STATIC_EXTENSIBLE_STRING, "Static");
-      lime::hdf5::write_static_field(file_id_, field, data);
-    }
-  }
-}
-
-template <class data_t>
-void FileH5::append(std::string field, data_t const &data) {
-  if (iomode_ == "r")
-    throw std::runtime_error("Lime error: cannot append in read mode");
-  else {
-    // Try to write to existing field
-    if (defined(field)) {
-      // Throw error if field is not extensible
-      if (!extensible(field)) {
-        auto msg = std::string("Lime error: can't append to "
-                               "non-extensible field.");
-        throw std::runtime_error(msg);
-      }
-
-      // Write to field if type/shape agree
-      if (lime::hdf5::append_compatible(file_id_, field, data))
-        lime::hdf5::append_extensible_field(file_id_, field, data);
-
-      // Type/shape don't agree -> throw error
-      else {
-        auto msg = std::string("Lime error: can't append to "
-                               "field. Incompatible type/shape");
-        throw std::runtime_error(msg);
-      }
-    }
-    // Create new field and append
-    else {
-      fields_.push_back(field);
-      std::string field_type = type_string(data);
-      field_types_[field] = field_type;
-      field_extensible_[field] = true;
-      lime::hdf5::create_extensible_field(file_id_, field, data);
-      set_attribute(field, LIME_FIELD_TYPE_STRING, field_type);
-      set_attribute(field, LIME_FIELD_STATIC_EXTENSIBLE_STRING, "Extensible");
-      lime::hdf5::append_extensible_field(file_id_, field, data);
-    }
-  }
+  if (!extensible(field))
+    return 1;
+  hid_t dataset_id = hdf5::open_dataset(file_id_, field);
+  auto dims = hdf5::get_dataspace_dims(dataset_id);
+  H5Dclose(dataset_id);
+  return (long)dims[0];
 }
 
 std::string FileH5::attribute(std::string field,
                               std::string attribute_name) const {
   std::string attribute_value;
   if (defined(field)) {
-    hid_t dataset_id = H5Dopen2(file_id_, field.c_str(), H5P_DEFAULT);
+    if (lime_attribute(attribute_name)) {
+      auto const &attributes = lime_attributes(field);
+      auto it = attributes.find(attribute_name);
+      if (it == attributes.end()) {
+        auto msg = std::string("Lime error: given attribute doesn't "
+                               "not defined");
+        throw std::runtime_error(msg);
+      }
+      return it->second;
+    }
+    hid_t dataset_id = hdf5::open_dataset(file_id_, field);
 
     if (H5Aexists(dataset_id, attribute_name.c_str()))
       attribute_value = hdf5::get_attribute_value(dataset_id, attribute_name);
     else {
+      H5Dclose(dataset_id);
       auto msg = std::string("Lime error: given attribute doesn't "
                              "not defined");
       throw std::runtime_error(msg);
@@ -271,7 +260,9 @@ std::string FileH5::attribute(std::string field,
 bool FileH5::has_attribute(std::string field, std::string attribute_name) {
   bool has_it = false;
   if (defined(field)) {
-    hid_t dataset_id = H5Dopen2(file_id_, field.c_str(), H5P_DEFAULT);
+    if (lime_attribute(attribute_name))
+      return lime_attributes(field).count(attribute_name) > 0;
+    hid_t dataset_id = hdf5::open_dataset(file_id_, field);
     has_it = H5Aexists(dataset_id, attribute_name.c_str());
     H5Dclose(dataset_id);
   } else {
@@ -284,124 +275,400 @@ bool FileH5::has_attribute(std::string field, std::string attribute_name) {
 
 void FileH5::set_attribute(std::string field, std::string attribute_name,
                            std::string attribute_value) {
-  if (defined(field)) {
-    hid_t dataset_id = H5Dopen2(file_id_, field.c_str(), H5P_DEFAULT);
-    hid_t str_type_id = H5Tcopy(H5T_C_S1);
-    hid_t string_space_id = H5Screate(H5S_SCALAR);
-    H5Tset_size(str_type_id, attribute_value.length());
-    hid_t attribute_id =
-        H5Acreate(dataset_id, attribute_name.c_str(), str_type_id,
-                  string_space_id, H5P_DEFAULT, H5P_DEFAULT);
-    H5Awrite(attribute_id, str_type_id, attribute_value.c_str());
-    H5Aclose(attribute_id);
-    H5Sclose(string_space_id);
-    H5Tclose(str_type_id);
-    H5Dclose(dataset_id);
-  } else {
+  set_attributes(field, {{attribute_name, attribute_value}});
+}
+
+std::map<std::string, std::string>
+FileH5::attributes(std::string field) const {
+  if (!defined(field)) {
+    auto msg = std::string("Lime error: can't get attributes of "
+                           "field. Field not found.");
+    throw std::runtime_error(msg);
+  }
+  hid_t dataset_id = hdf5::open_dataset(file_id_, field);
+  auto attributes = hdf5::get_attribute_values(dataset_id);
+  H5Dclose(dataset_id);
+
+  auto &cached = lime_attributes_[field];
+  cached.clear();
+  for (auto const &it : attributes)
+    if (lime_attribute(it.first))
+      cached.insert(it);
+  return attributes;
+}
+
+void FileH5::set_attributes(
+    std::string field, std::map<std::string, std::string> const &attributes) {
+  if (!defined(field)) {
+    auto msg = std::string("Lime error: can't attribute to "
+                           "field. Field not found.");
+    throw std::runtime_error(msg);
+  }
+  hid_t dataset_id = hdf5::open_dataset(file_id_, field);
+  hdf5::set_attribute_values(dataset_id, attributes);
+  H5Dclose(dataset_id);
+
+  // Cached attributes are updated, others are cached on first use
+  auto cached = lime_attributes_.find(field);
+  if (cached != lime_attributes_.end())
+    for (auto const &it : attributes)
+      if (lime_attribute(it.first))
+        cached->second[it.first] = it.second;
+}
+
+void FileH5::set_attribute_data(std::string const &field,
+                                std::string const &attribute_name,
+                                hid_t datatype_id,
+                                std::vector<hsize_t> const &dims,
+                                const void *data) {
+  if (!defined(field)) {
     auto msg = std::string("Lime error: can't attribute to "
                            "field. Field not found.");
     throw std::runtime_error(msg);
   }
+  hid_t dataset_id = hdf5::open_dataset(file_id_, field);
+  hdf5::set_attribute_data(dataset_id, attribute_name, datatype_id, dims,
+                           data);
+  H5Dclose(dataset_id);
+  if (lime_attribute(attribute_name))
+    lime_attributes_.erase(field);
 }
 
+void FileH5::attribute_data(std::string const &field,
+                            std::string const &attribute_name,
+                            hid_t datatype_id,
+                            hdf5::EntryAllocator const &allocate) const {
+  if (!defined(field)) {
+    auto msg = std::string("Lime error: can't attribute to "
+                           "field. Field not found.");
+    throw std::runtime_error(msg);
+  }
+  hid_t dataset_id = hdf5::open_dataset(file_id_, field);
+  bool read =
+      hdf5::get_attribute_data(dataset_id, attribute_name, datatype_id,
+                               allocate);
+  H5Dclose(dataset_id);
+  if (!read) {
+    auto msg = std::string("Lime error: attribute not defined or of "
+                           "wrong type/size: ") +
+               attribute_name;
+    throw std::runtime_error(msg);
+  }
+}
+
+std::map<std::string, std::string> const &
+FileH5::lime_attributes(std::string const &field) const {
+  auto cached = lime_attributes_.find(field);
+  if (cached == lime_attributes_.end()) {
+    attributes(field);
+    cached = lime_attributes_.find(field);
+  }
+  return cached->second;
+}
+
+long FileH5::bit_count(std::string const &field) const {
+  auto const &attributes = lime_attributes(field);
+  auto it = attributes.find(LIME_FIELD_BIT_COUNT_STRING);
+  return (it == attributes.end()) ? -1 : std::stol(it->second);
+}
+
+std::string FileH5::record_types(std::string const &field) const {
+  auto const &attributes = lime_attributes(field);
+  auto it = attributes.find(LIME_FIELD_RECORD_TYPES_STRING);
+  return (it == attributes.end()) ? "" : it->second;
+}
+
+bool FileH5::record_types_compatible(std::string const &field,
+                                     Record const &record) const {
+  std::string types = record_types(field);
+  return types.empty() || (types == record.member_types());
+}
+
+void FileH5::set_storage(std::string field, FieldStorage const &storage) {
+  if (defined(field)) {
+    auto msg = std::string("Lime error: can't set storage of already "
+                           "existing field: ") +
+               field;
+    throw std::runtime_error(msg);
+  }
+  field_storage_[field] = storage;
+}
+
+void FileH5::collect_stats(bool collect) { collect_stats_ = collect; }
+
+std::map<std::string, FieldStats> FileH5::stats() const { return stats_; }
+
+FieldStats FileH5::stats(std::string field) const {
+  auto it = stats_.find(field);
+  return (it == stats_.end()) ? FieldStats() : it->second;
+}
+
+void FileH5::write_stats() {
+  for (auto const &it : stats_)
+    if (defined(it.first))
+      set_attribute(it.first, LIME_FIELD_STATS_STRING,
+                    stats_string(it.second));
+}
+
+hdf5::FieldScope FileH5::field_scope(std::string const &field,
+                                     bool create) const {
+  // Operations on missing fields fail without statistics
+  if (!defined(field))
+    return hdf5::FieldScope(
+        file_id_, field,
+        (collect_stats_ && create) ? &stats_[field] : nullptr,
+        H5I_INVALID_HID);
+  return hdf5::FieldScope(file_id_, field,
+                          collect_stats_ ? &stats_[field] : nullptr,
+                          kept_dataset(field));
+}
+
+void FileH5::set_chunk_cache(std::string field, ChunkCache const &cache) {
+  chunk_caches_[field] = cache;
+  release_dataset(field);
+}
+
+hid_t FileH5::kept_dataset(std::string const &field) const {
+  if (!defined(field))
+    return H5I_INVALID_HID;
+  auto it = open_datasets_.find(field);
+  if (it != open_datasets_.end()) {
+    open_order_.remove(field);
+    open_order_.push_front(field);
+    return it->second;
+  }
+
+  // The chunk cache is sized once from the chunks of the field, the
+  // dataset opened to find them is kept if possible
+  hid_t dataset_id;
+  auto plist = access_plists_.find(field);
+  if (plist == access_plists_.end()) {
+    auto cache = chunk_caches_.find(field);
+    hid_t access_id;
+    dataset_id = hdf5::open_chunked_dataset(
+        file_id_, field,
+        (cache == chunk_caches_.end()) ? ChunkCache() : cache->second,
+        iomode_ != "r", access_id);
+    access_plists_.emplace(field, access_id);
+  } else if (plist->second >= 0)
+    dataset_id = H5Dopen2(file_id_, field.c_str(), plist->second);
+  else
+    dataset_id = H5I_INVALID_HID;
+
+  // Unchunked fields are not kept, least recently used ones are closed
+  if (dataset_id < 0)
+    return H5I_INVALID_HID;
+  if (collect_stats_)
+    ++stats_[field].dataset_opens;
+  open_datasets_[field] = dataset_id;
+  open_order_.push_front(field);
+  if (open_order_.size() > LIME_MAX_OPEN_DATASETS)
+    release_dataset(open_order_.back());
+  return dataset_id;
+}
+
+void FileH5::release_dataset(std::string const &field) const {
+  auto it = open_datasets_.find(field);
+  if (it != open_datasets_.end()) {
+    H5Dclose(it->second);
+    open_datasets_.erase(it);
+    open_order_.remove(field);
+  }
+  auto plist = access_plists_.find(field);
+  if ((plist != access_plists_.end()) &&
+      (chunk_caches_.find(field) != chunk_caches_.end())) {
+    if (plist->second >= 0)
+      H5Pclose(plist->second);
+    access_plists_.erase(plist);
+  }
+}
+
+FieldStorage FileH5::storage(std::string field) const {
+  auto it = field_storage_.find(field);
+  return (it == field_storage_.end()) ? FieldStorage() : it->second;
+}
+
+void FileH5::read(std::string field, Record &record) const {
+  auto scope = field_scope(field);
+  check_record_field(*this, field, false);
+  record = record_layout(file_id_, field, record_types(field));
+  hid_t datatype_id = record.create_datatype();
+  lime::hdf5::read_into(file_id_, field, datatype_id, -1, record.data(), 1);
+  H5Tclose(datatype_id);
+  hdf5::count_read(record.nbytes());
+}
+
+void FileH5::read(std::string field, std::vector<Record> &records) const {
+  auto scope = field_scope(field);
+  check_record_field(*this, field, true);
+  Record layout = record_layout(file_id_, field, record_types(field));
+  long n_records = size(field);
+  std::vector<char> buffer((size_t)n_records * layout.nbytes());
+  hid_t datatype_id = layout.create_datatype();
+  lime::hdf5::read_into(file_id_, field, datatype_id, -1, buffer.data(),
+                        (hsize_t)n_records);
+  H5Tclose(datatype_id);
+
+  // Records already holding the members of the field are reused
+  records.resize(n_records);
+  for (long idx = 0; idx < n_records; ++idx) {
+    if (!records[idx].same_members(layout))
+      records[idx] = layout;
+    std::copy(buffer.data() + idx * layout.nbytes(),
+              buffer.data() + (idx + 1) * layout.nbytes(),
+              records[idx].data());
+  }
+  hdf5::count_read(buffer.size());
+}
+
+void FileH5::read(std::string field, long idx, Record &record) const {
+  auto scope = field_scope(field);
+  check_record_field(*this, field, true);
+  if ((idx < 0) || (idx >= size(field))) {
+    auto msg = std::string("Lime error: index out of range while "
+                           "trying to read: ") +
+               field;
+    throw std::runtime_error(msg);
+  }
+  Record layout = record_layout(file_id_, field, record_types(field));
+  if (!record.same_members(layout))
+    record = layout;
+  hid_t datatype_id = record.create_datatype();
+  lime::hdf5::read_into(file_id_, field, datatype_id, idx, record.data(), 1);
+  H5Tclose(datatype_id);
+  hdf5::count_read(record.nbytes());
+}
+
+void FileH5::write(std::string field, Record const &record, bool force) {
+  auto scope = field_scope(field, true);
+  if (iomode_ == "r")
+    throw std::runtime_error("Lime error: cannot write in read mode");
+  if (record.members().empty())
+    throw std::runtime_error("Lime error: can't write record without "
+                             "members");
+
+  if (defined(field)) {
+    if (!force) {
+      auto msg = std::string("Lime error: can't write to already "
+                             "existing field. Use parameter "
+                             "force=true to overwrite");
+      throw std::runtime_error(msg);
+    }
+    if (extensible(field)) {
+      auto msg = std::string("Lime error: can't write to "
+                             "extensible field. "
+                             "Must be appended");
+      throw std::runtime_error(msg);
+    }
+    hid_t datatype_id = record.create_datatype();
+    bool compatible =
+        record_types_compatible(field, record) &&
+        lime::hdf5::write_compatible(file_id_, field, datatype_id, {}, false);
+    if (compatible) {
+      lime::hdf5::write_static_field(file_id_, field, datatype_id,
+                                     record.data(), false);
+      hdf5::count_write(record.nbytes());
+    }
+    H5Tclose(datatype_id);
+    if (!compatible) {
+      auto msg = std::string("Lime error: can't write to "
+                             "field. Incompatible type/shape");
+      throw std::runtime_error(msg);
+    }
+  } else {
+    fields_.push_back(field);
+    field_types_[field] = "Record";
+    field_extensible_[field] = false;
+    hid_t datatype_id = record.create_datatype();
+    lime::hdf5::create_static_field(file_id_, field, datatype_id, {}, false);
+    set_attributes(field,
+                   {{LIME_FIELD_TYPE_STRING, "Record"},
+                    {LIME_FIELD_STATIC_EXTENSIBLE_STRING, "Static"},
+                    {LIME_FIELD_RECORD_TYPES_STRING, record.member_types()}});
+    lime::hdf5::write_static_field(file_id_, field, datatype_id,
+                                   record.data(), false);
+    H5Tclose(datatype_id);
+    hdf5::count_write(record.nbytes());
+  }
+}
+
+void FileH5::append(std::string field, Record const &record) {
+  append(field, &record, 1);
+}
+
+void FileH5::append(std::string field, Record const *records,
+                    long n_records) {
+  auto scope = field_scope(field, true);
+  if (iomode_ == "r")
+    throw std::runtime_error("Lime error: cannot append in read mode");
+  else if (n_records <= 0)
+    return;
+  if (records[0].members().empty())
+    throw std::runtime_error("Lime error: can't append record without "
+                             "members");
+  for (long idx = 1; idx < n_records; ++idx)
+    if (!records[idx].same_members(records[0])) {
+      auto msg = std::string("Lime error: can't append records with "
+                             "different members at once");
+      throw std::runtime_error(msg);
+    }
+
+  hid_t datatype_id = records[0].create_datatype();
+  auto entry = [records](hsize_t idx) -> const void * {
+    return records[idx].data();
+  };
+  if (defined(field)) {
+    bool compatible =
+        extensible(field) && record_types_compatible(field, records[0]) &&
+        lime::hdf5::append_compatible(file_id_, field, datatype_id, {}, false);
+    if (compatible) {
+      lime::hdf5::append_extensible_field(file_id_, field, datatype_id, entry,
+                                          (hsize_t)n_records, false);
+      hdf5::count_append(n_records, n_records * records[0].nbytes());
+    }
+    H5Tclose(datatype_id);
+    if (!compatible) {
+      auto msg = std::string("Lime error: can't append to field. "
+                             "Not extensible or incompatible members: ") +
+                 field;
+      throw std::runtime_error(msg);
+    }
+  } else {
+    fields_.push_back(field);
+    field_types_[field] = "Record";
+    field_extensible_[field] = true;
+    lime::hdf5::create_extensible_field(file_id_, field, datatype_id, {},
+                                        false, hdf5::default_chunk_size(0));
+    set_attributes(field,
+                   {{LIME_FIELD_TYPE_STRING, "Record"},
+                    {LIME_FIELD_STATIC_EXTENSIBLE_STRING, "Extensible"},
+                    {LIME_FIELD_RECORD_TYPES_STRING,
+                     records[0].member_types()}});
+    lime::hdf5::append_extensible_field(file_id_, field, datatype_id, entry,
+                                        (hsize_t)n_records, false);
+    H5Tclose(datatype_id);
+    hdf5::count_append(n_records, n_records * records[0].nbytes());
+  }
+}
+
+void FileH5::flush() { H5Fflush(file_id_, H5F_SCOPE_GLOBAL); }
+
 void FileH5::close() {
-  H5Fclose(file_id_);
+  for (auto const &it : open_datasets_)
+    H5Dclose(it.second);
+  for (auto const &it : access_plists_)
+    if (it.second >= 0)
+      H5Pclose(it.second);
+  open_datasets_.clear();
+  open_order_.clear();
+  access_plists_.clear();
+  if (group_file_id_ >= 0) {
+    H5Gclose(file_id_);
+    H5Fclose(group_file_id_);
+    group_file_id_ = H5I_INVALID_HID;
+  } else
+    H5Fclose(file_id_);
   file_id_ = hid_t();
 }
 
 } // namespace lime
-
-// Write instantiations
-template void lime::FileH5::write(std::string, int const &, bool);
-template void lime::FileH5::write(std::string, unsigned const &, bool);
-template void lime::FileH5::write(std::string, long const &, bool);
-template void lime::FileH5::write(std::string, unsigned long const &, bool);
-template void lime::FileH5::write(std::string, long long const &, bool);
-template void lime::FileH5::write(std::string, unsigned long long const &,
-                                  bool);
-
-template void lime::FileH5::write(std::string, sscalar const &, bool);
-template void lime::FileH5::write(std::string, dscalar const &, bool);
-template void lime::FileH5::write(std::string, cscalar const &, bool);
-template void lime::FileH5::write(std::string, zscalar const &, bool);
-
-template void lime::FileH5::write(std::string, svector const &, bool);
-template void lime::FileH5::write(std::string, dvector const &, bool);
-template void lime::FileH5::write(std::string, cvector const &, bool);
-template void lime::FileH5::write(std::string, zvector const &, bool);
-
-template void lime::FileH5::write(std::string, smatrix const &, bool);
-template void lime::FileH5::write(std::string, dmatrix const &, bool);
-template void lime::FileH5::write(std::string, cmatrix const &, bool);
-template void lime::FileH5::write(std::string, zmatrix const &, bool);
-
-// Read static instantiations
-template void lime::FileH5::read(std::string, int &) const;
-template void lime::FileH5::read(std::string, unsigned &) const;
-template void lime::FileH5::read(std::string, long &) const;
-template void lime::FileH5::read(std::string, unsigned long &) const;
-template void lime::FileH5::read(std::string, long long &) const;
-template void lime::FileH5::read(std::string, unsigned long long &) const;
-
-template void lime::FileH5::read(std::string, sscalar &) const;
-template void lime::FileH5::read(std::string, dscalar &) const;
-template void lime::FileH5::read(std::string, cscalar &) const;
-template void lime::FileH5::read(std::string, zscalar &) const;
-
-template void lime::FileH5::read(std::string, svector &) const;
-template void lime::FileH5::read(std::string, dvector &) const;
-template void lime::FileH5::read(std::string, cvector &) const;
-template void lime::FileH5::read(std::string, zvector &) const;
-
-template void lime::FileH5::read(std::string, smatrix &) const;
-template void lime::FileH5::read(std::string, dmatrix &) const;
-template void lime::FileH5::read(std::string, cmatrix &) const;
-template void lime::FileH5::read(std::string, zmatrix &) const;
-
-// Read extensible instantiations
-template void lime::FileH5::read(std::string, std::vector<int> &) const;
-template void lime::FileH5::read(std::string, std::vector<unsigned> &) const;
-template void lime::FileH5::read(std::string, std::vector<long> &) const;
-template void lime::FileH5::read(std::string,
-                                 std::vector<unsigned long> &) const;
-template void lime::FileH5::read(std::string, std::vector<long long> &) const;
-template void lime::FileH5::read(std::string,
-                                 std::vector<unsigned long long> &) const;
-
-template void lime::FileH5::read(std::string, std::vector<sscalar> &) const;
-template void lime::FileH5::read(std::string, std::vector<dscalar> &) const;
-template void lime::FileH5::read(std::string, std::vector<cscalar> &) const;
-template void lime::FileH5::read(std::string, std::vector<zscalar> &) const;
-
-template void lime::FileH5::read(std::string, std::vector<svector> &) const;
-template void lime::FileH5::read(std::string, std::vector<dvector> &) const;
-template void lime::FileH5::read(std::string, std::vector<cvector> &) const;
-template void lime::FileH5::read(std::string, std::vector<zvector> &) const;
-
-template void lime::FileH5::read(std::string, std::vector<smatrix> &) const;
-template void lime::FileH5::read(std::string, std::vector<dmatrix> &) const;
-template void lime::FileH5::read(std::string, std::vector<cmatrix> &) const;
-template void lime::FileH5::read(std::string, std::vector<zmatrix> &) const;
-
-// append instantiations
-template void lime::FileH5::append(std::string, int const &);
-template void lime::FileH5::append(std::string, unsigned const &);
-template void lime::FileH5::append(std::string, long const &);
-template void lime::FileH5::append(std::string, unsigned long const &);
-template void lime::FileH5::append(std::string, long long const &);
-template void lime::FileH5::append(std::string, unsigned long long const &);
-
-template void lime::FileH5::append(std::string, sscalar const &);
-template void lime::FileH5::append(std::string, dscalar const &);
-template void lime::FileH5::append(std::string, cscalar const &);
-template void lime::FileH5::append(std::string, zscalar const &);
-
-template void lime::FileH5::append(std::string, svector const &);
-template void lime::FileH5::append(std::string, dvector const &);
-template void lime::FileH5::append(std::string, cvector const &);
-template void lime::FileH5::append(std::string, zvector const &);
-
-template void lime::FileH5::append(std::string, smatrix const &);
-template void lime::FileH5::append(std::string, dmatrix const &);
-template void lime::FileH5::append(std::string, cmatrix const &);
-template void lime::FileH5::append(std::string, zmatrix const &);
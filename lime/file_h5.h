@@ -16,12 +16,46 @@
 #define LIME_FILE_H5_H
 
 #include <hdf5.h>
+#include <list>
 #include <map>
+#include <stdexcept>
 #include <string>
 #include <vector>
+#if __cplusplus >= 202002L
+#include <span>
+#endif
 
+#include <lime/attribute_traits.h>
+#include <lime/chunk_cache.h>
+#include <lime/field_storage.h>
+#include <lime/file_h5_options.h>
+#include <lime/io_stats.h>
 #include <lime/file_h5_handler.h>
+#include <lime/mapped_field.h>
+#include <lime/record.h>
+#include <lime/tensor.h>
+#include <lime/type_string.h>
+
+#include <lime/hdf5/field_scope.h>
 #include <lime/hdf5/parse_file.h>
+#include <lime/hdf5/types.h>
+#include <lime/hdf5/utils.h>
+
+#include <lime/hdf5/create_static_field.h>
+#include <lime/hdf5/read_static_compatible.h>
+#include <lime/hdf5/read_static_field.h>
+#include <lime/hdf5/write_compatible.h>
+#include <lime/hdf5/write_static_field.h>
+
+#include <lime/hdf5/append_compatible.h>
+#include <lime/hdf5/append_extensible_field.h>
+#include <lime/hdf5/create_extensible_field.h>
+#include <lime/hdf5/read_extensible_compatible.h>
+#include <lime/hdf5/read_extensible_element.h>
+#include <lime/hdf5/read_extensible_field.h>
+#include <lime/hdf5/read_hyperslab.h>
+#include <lime/hdf5/read_into.h>
+#include <lime/hdf5/read_member.h>
 
 namespace lime {
 
@@ -31,7 +65,19 @@ public:
   FileH5() = default;
   operator bool() const; // returns whether default constructed
 
-  FileH5(std::string filename, std::string iomode = "r");
+  // Fields of a file opened on a group are given relative to the group and
+  // only the group is parsed. The group is created in write modes.
+  FileH5(std::string filename, std::string iomode = "r",
+         std::string group = "");
+  FileH5(std::string filename, std::string iomode,
+         FileH5Options const &options, std::string group = "");
+
+  // In-memory file opened from the image of a file (iomode r or a), the
+  // image of a file is its content as a byte buffer, e.g. to be sent
+  // to another process
+  static FileH5 from_image(std::vector<char> const &image,
+                           std::string iomode = "r", std::string group = "");
+  std::vector<char> image() const;
   ~FileH5() = default;
 
   FileH5(FileH5 const &other) = delete;            // FileH5 can't be copied
@@ -42,27 +88,113 @@ public:
 
   inline std::string filename() const { return filename_; }
   inline std::string iomode() const { return iomode_; }
+  inline std::string group() const { return group_; }
+  inline FileH5Options options() const { return options_; }
   inline std::vector<std::string> fields() const { return fields_; }
+  inline hid_t file_id() const { return file_id_; }
+
+  // Fields below a group given by its path, and all groups holding fields
+  std::vector<std::string> fields(std::string group) const;
+  std::vector<std::string> groups() const;
 
   bool defined(std::string field) const;
   std::string type(std::string field) const;
   bool extensible(std::string field) const;
+  long size(std::string field) const;
 
   template <class data_t> void read(std::string field, data_t &data) const;
 
   template <class data_t>
   void read(std::string field, std::vector<data_t> &data) const;
 
+  template <class data_t>
+  void read(std::string field, long idx, data_t &data) const;
+
+  template <class coeff_t> MappedField<coeff_t> map(std::string field) const;
+
   template <class data_t>
   void write(std::string field, data_t const &data, bool force = false);
 
   template <class data_t> void append(std::string field, data_t const &data);
 
+  // Append several entries of the same shape with a single write
+  template <class data_t>
+  void append(std::string field, std::vector<data_t> const &data);
+  template <class data_t>
+  void append(std::string field, data_t const *entries, long n_entries);
+
+  // Read all coefficients of a field, or of entry idx of an extensible
+  // field, into preallocated memory holding size coefficients. Coefficients
+  // are given in storage order of the dataset (as for map).
+  template <class coeff_t>
+  void read_into(std::string field, coeff_t *buffer, long size) const;
+  template <class coeff_t>
+  void read_into(std::string field, long idx, coeff_t *buffer,
+                 long size) const;
+#ifdef __cpp_lib_span
+  template <class coeff_t>
+  void read_into(std::string field, std::span<coeff_t> buffer) const {
+    read_into(field, buffer.data(), (long)buffer.size());
+  }
+  template <class coeff_t>
+  void read_into(std::string field, long idx,
+                 std::span<coeff_t> buffer) const {
+    read_into(field, idx, buffer.data(), (long)buffer.size());
+  }
+#endif
+
+  // Read a block of a field with given offset and extent in each dimension
+  // of the dataset, the first dimension of extensible fields enumerates
+  // the entries and matrices are stored column-major (as for map)
+  template <class coeff_t>
+  void read_hyperslab(std::string field, std::vector<hsize_t> const &offset,
+                      std::vector<hsize_t> const &count,
+                      Tensor<coeff_t> &block) const;
+
+  // Records are stored as compound fields with one member per observable,
+  // such that all observables are appended with a single write. Single
+  // members can be read from all entries of a record field.
+  void read(std::string field, Record &record) const;
+  void read(std::string field, std::vector<Record> &records) const;
+  void read(std::string field, long idx, Record &record) const;
+  void write(std::string field, Record const &record, bool force = false);
+  void append(std::string field, Record const &record);
+  void append(std::string field, Record const *records, long n_records);
+  template <class coeff_t>
+  void read_member(std::string field, std::string member,
+                   std::vector<coeff_t> &values) const;
+
   std::string attribute(std::string field, std::string attribute_name) const;
   bool has_attribute(std::string field, std::string attribute_name);
   void set_attribute(std::string field, std::string attribute_name,
                      std::string attribute_value);
 
+  // Typed attributes, e.g. run parameters, stored with native hdf5 types:
+  // integers, floating point and complex numbers or std::vectors of them.
+  // Integers and floating point numbers are converted into each other.
+  template <class value_t,
+            class = std::enable_if_t<typed_attribute<value_t>>>
+  void set_attribute(std::string field, std::string attribute_name,
+                     value_t const &value);
+  template <class value_t>
+  void attribute(std::string field, std::string attribute_name,
+                 value_t &value) const;
+
+  // All attributes of a field, read or written with a single open of the
+  // field. Lime's own attributes (LimeField...) are cached.
+  std::map<std::string, std::string> attributes(std::string field) const;
+  void set_attributes(std::string field,
+                      std::map<std::string, std::string> const &attributes);
+
+  // Storage of coefficients on disk, needs to be set before the field is
+  // created by its first write/append
+  void set_storage(std::string field, FieldStorage const &storage);
+
+  // Chunk cache of a field. Chunked fields are kept open with their cache
+  // between operations (at most LIME_MAX_OPEN_DATASETS at a time), such
+  // that chunks are not re-read and re-compressed on every append.
+  void set_chunk_cache(std::string field, ChunkCache const &cache);
+
   FileH5Handler operator[](std::string const &field) {
     return FileH5Handler(field, *this);
   }
@@ -71,6 +203,14 @@ public:
     return operator[](std::string(field));
   }
 
+  // I/O statistics of every field, collected while collect_stats is set.
+  // write_stats stores them as attribute of the fields.
+  void collect_stats(bool collect = true);
+  std::map<std::string, FieldStats> stats() const;
+  FieldStats stats(std::string field) const;
+  void write_stats();
+
+  void flush();
   void close();
 
   friend herr_t lime::hdf5::parse_file(hid_t loc_id, const char *name,
@@ -79,13 +219,545 @@ public:
 private:
   std::string filename_;
   std::string iomode_;
+  std::string group_;
+  FileH5Options options_;
   std::vector<std::string> fields_;
   std::map<std::string, std::string> field_types_;
   std::map<std::string, bool> field_extensible_;
+  std::map<std::string, FieldStorage> field_storage_;
+  mutable std::map<std::string, std::map<std::string, std::string>>
+      lime_attributes_;
+  bool collect_stats_ = false;
+  mutable std::map<std::string, FieldStats> stats_;
+  std::map<std::string, ChunkCache> chunk_caches_;
+  mutable std::map<std::string, hid_t> access_plists_;
+  mutable std::map<std::string, hid_t> open_datasets_;
+  mutable std::list<std::string> open_order_; // most recently used first
+
+  hid_t file_id_; // location of the fields, i.e. the file or the group
+  hid_t group_file_id_ = H5I_INVALID_HID;
+
+  FieldStorage storage(std::string field) const;
+
+  // Activates the statistics (if collected) and the kept dataset of a
+  // field for an operation, missing fields only if they are created
+  void open_fields();
+  hdf5::FieldScope field_scope(std::string const &field,
+                               bool create = false) const;
+  hid_t kept_dataset(std::string const &field) const;
+  void release_dataset(std::string const &field) const;
+
+  std::map<std::string, std::string> const &
+  lime_attributes(std::string const &field) const;
+  void set_attribute_data(std::string const &field,
+                          std::string const &attribute_name,
+                          hid_t datatype_id, std::vector<hsize_t> const &dims,
+                          const void *data);
+  void attribute_data(std::string const &field,
+                      std::string const &attribute_name, hid_t datatype_id,
+                      hdf5::EntryAllocator const &allocate) const;
+
+  // Extensible fields repacked contiguously have a fixed extent
+  bool appendable(std::string const &field) const;
 
-  hid_t file_id_;
+  // Record fields keep the coefficient types of their members in an
+  // attribute, fields written without it accept any record types
+  std::string record_types(std::string const &field) const;
+  bool record_types_compatible(std::string const &field,
+                               Record const &record) const;
+
+  // Packed fields keep the number of values per entry in an attribute
+  long bit_count(std::string const &field) const;
+  template <class data_t>
+  bool packed_compatible(std::string field, data_t const &data) const;
+  template <class data_t>
+  void set_packed(std::string field, data_t const &data);
+  template <class data_t> void unpack(std::string field, data_t &data) const;
 };
 
+template <class value_t, class>
+void FileH5::set_attribute(std::string field, std::string attribute_name,
+                           value_t const &value) {
+  using traits = attribute_traits<value_t>;
+  set_attribute_data(field, attribute_name,
+                     hdf5::hdf5_datatype<typename traits::coeff_type>(),
+                     traits::dims(value), traits::data(value));
+}
+
+template <class value_t>
+void FileH5::attribute(std::string field, std::string attribute_name,
+                       value_t &value) const {
+  using traits = attribute_traits<value_t>;
+  static_assert(traits::typed, "Lime error: invalid type of attribute");
+  attribute_data(field, attribute_name,
+                 hdf5::hdf5_datatype<typename traits::coeff_type>(),
+                 [&value](std::vector<hsize_t> const &dims) {
+                   return traits::resize(value, dims);
+                 });
+}
+
+template <class data_t>
+bool FileH5::packed_compatible(std::string field, data_t const &data) const {
+  if constexpr (field_traits<data_t>::packed) {
+    return bit_count(field) == field_traits<data_t>::bit_count(data);
+  } else
+    return true;
+}
+
+template <class data_t>
+void FileH5::set_packed(std::string field, data_t const &data) {
+  if constexpr (field_traits<data_t>::packed)
+    set_attribute(field, LIME_FIELD_BIT_COUNT_STRING,
+                  std::to_string(field_traits<data_t>::bit_count(data)));
+}
+
+template <class data_t>
+void FileH5::unpack(std::string field, data_t &data) const {
+  if constexpr (field_traits<data_t>::packed) {
+    long count = bit_count(field);
+    if (count < 0) {
+      auto msg = std::string("Lime error: missing bit count of packed "
+                             "field: ") +
+                 field;
+      throw std::runtime_error(msg);
+    }
+    field_traits<data_t>::set_bit_count(data, count);
+  }
+}
+
+template <class data_t>
+void FileH5::read(std::string field, data_t &data) const {
+  auto scope = field_scope(field);
+  // Read a field into data
+  if (defined(field)) {
+    // check if field datatype agrees with data
+    if (type(field) != type_string(data)) {
+      auto msg = std::string("Lime error: wrong field type in read");
+      throw std::runtime_error(msg);
+    }
+
+    // check if field extensibility is static
+    if (extensible(field)) {
+      auto msg = std::string("Lime error: trying to read a static "
+                             "field from non-static dataset");
+      throw std::runtime_error(msg);
+    }
+
+    // Check if low level dimensions are OK
+    if (lime::hdf5::read_static_compatible(file_id_, field, data)) {
+      lime::hdf5::read_static_field(file_id_, field, data);
+      unpack(field, data);
+      hdf5::count_read(entry_bytes(data));
+    } else {
+      auto msg = std::string("Lime error: cannot read static field! "
+                             "Wrong type/shape of field: ") +
+                 field;
+      throw std::runtime_error(msg);
+    }
+  }
+  // Throw error "Field not found"
+  else {
+    auto msg = std::string("Lime error: field not found while "
+                           "trying to read: ") +
+               field;
+    throw std::runtime_error(msg);
+  }
+}
+
+template <class data_t>
+void FileH5::read(std::string field, std::vector<data_t> &data) const {
+  auto scope = field_scope(field);
+  // Read a field into data
+  if (defined(field)) {
+    // check if field datatype agrees with data
+    if (type(field) != type_string(data)) {
+      auto msg = std::string("Lime error: wrong field type in read");
+      throw std::runtime_error(msg);
+    }
+
+    // check if is extensible
+    if (!extensible(field)) {
+      auto msg = std::string("Lime error: trying to read an "
+                             "extensible field from non-extensible "
+                             "dataset");
+      throw std::runtime_error(msg);
+    }
+
+    // Check if low level dimensions are OK
+    if (lime::hdf5::read_extensible_compatible(file_id_, field, data)) {
+      lime::hdf5::read_extensible_field(file_id_, field, data);
+      size_t bytes = 0;
+      for (auto &entry : data) {
+        unpack(field, entry);
+        bytes += entry_bytes(entry);
+      }
+      hdf5::count_read(bytes);
+    } else {
+      auto msg = std::string("Lime error: cannot read extensible "
+                             "field! Wrong type/shape of field: ") +
+                 field;
+      throw std::runtime_error(msg);
+    }
+  }
+  // Throw error "Field not found"
+  else {
+    auto msg = std::string("Lime error: field not found while "
+                           "trying to read: ") +
+               field;
+    throw std::runtime_error(msg);
+  }
+}
+
+template <class data_t>
+void FileH5::read(std::string field, long idx, data_t &data) const {
+  auto scope = field_scope(field);
+  // Read a single entry of an extensible field into data
+  if (defined(field)) {
+    // check if field datatype agrees with data
+    if (type(field) != type_string(data)) {
+      auto msg = std::string("Lime error: wrong field type in read");
+      throw std::runtime_error(msg);
+    }
+
+    // check if is extensible
+    if (!extensible(field)) {
+      auto msg = std::string("Lime error: trying to read an entry of "
+                             "a non-extensible field");
+      throw std::runtime_error(msg);
+    }
+
+    if ((idx < 0) || (idx >= size(field))) {
+      auto msg = std::string("Lime error: index out of range while "
+                             "trying to read: ") +
+                 field;
+      throw std::runtime_error(msg);
+    }
+    lime::hdf5::read_extensible_element(file_id_, field, (hsize_t)idx, data);
+    unpack(field, data);
+    hdf5::count_read(entry_bytes(data));
+  }
+  // Throw error "Field not found"
+  else {
+    auto msg = std::string("Lime error: field not found while "
+                           "trying to read: ") +
+               field;
+    throw std::runtime_error(msg);
+  }
+}
+
+template <class coeff_t>
+MappedField<coeff_t> FileH5::map(std::string field) const {
+  if (!defined(field)) {
+    auto msg = std::string("Lime error: field not found while "
+                           "trying to map: ") +
+               field;
+    throw std::runtime_error(msg);
+  }
+
+  auto scope = field_scope(field);
+  MappedField<coeff_t> mapped;
+  hid_t dataset_id = hdf5::open_dataset(file_id_, field);
+  hid_t datatype_id = H5Dget_type(dataset_id);
+  bool exact = H5Tequal(datatype_id, hdf5::hdf5_datatype<coeff_t>()) > 0;
+  H5Tclose(datatype_id);
+  bool compatible =
+      exact ||
+      hdf5::datatype_compatible(dataset_id, hdf5::hdf5_datatype<coeff_t>());
+  if (!compatible) {
+    H5Dclose(dataset_id);
+    auto msg = std::string("Lime error: wrong entry type in map: ") + field;
+    throw std::runtime_error(msg);
+  }
+
+  mapped.shape_ = hdf5::get_dataspace_dims(dataset_id);
+  mapped.size_ = 1;
+  for (auto dim : mapped.shape_)
+    mapped.size_ *= (size_t)dim;
+
+  // Map raw data if contiguous, uncompressed and stored with the entry type,
+  // otherwise read to buffer (converting reduced precision). In-memory files
+  // are not on disk (yet).
+  haddr_t offset;
+  if (exact && (mapped.size_ > 0) && !options_.in_memory &&
+      hdf5::get_contiguous_offset(dataset_id, offset)) {
+    if (iomode_ != "r")
+      H5Fflush(file_id_, H5F_SCOPE_LOCAL);
+    mapped.region_ = MappedRegion(filename_, (size_t)offset,
+                                  mapped.size_ * sizeof(coeff_t));
+  } else {
+    mapped.buffer_.resize(mapped.size_);
+    if (mapped.size_ > 0)
+      H5Dread(dataset_id, hdf5::hdf5_datatype<coeff_t>(), H5S_ALL, H5S_ALL,
+              H5P_DEFAULT, mapped.buffer_.data());
+  }
+  H5Dclose(dataset_id);
+  hdf5::count_read(mapped.size_ * sizeof(coeff_t));
+  return mapped;
+}
+
+template <class coeff_t>
+void FileH5::read_into(std::string field, coeff_t *buffer, long size) const {
+  if (!defined(field)) {
+    auto msg = std::string("Lime error: field not found while "
+                           "trying to read: ") +
+               field;
+    throw std::runtime_error(msg);
+  }
+  auto scope = field_scope(field);
+  lime::hdf5::read_into(file_id_, field, hdf5::hdf5_datatype<coeff_t>(), -1,
+                        buffer, (hsize_t)size);
+  hdf5::count_read(size * sizeof(coeff_t));
+}
+
+template <class coeff_t>
+void FileH5::read_into(std::string field, long idx, coeff_t *buffer,
+                       long size) const {
+  if (!defined(field)) {
+    auto msg = std::string("Lime error: field not found while "
+                           "trying to read: ") +
+               field;
+    throw std::runtime_error(msg);
+  }
+  if (!extensible(field) || (idx < 0)) {
+    auto msg = std::string("Lime error: can only read entries with "
+                           "non-negative index of extensible field: ") +
+               field;
+    throw std::runtime_error(msg);
+  }
+  auto scope = field_scope(field);
+  lime::hdf5::read_into(file_id_, field, hdf5::hdf5_datatype<coeff_t>(), idx,
+                        buffer, (hsize_t)size);
+  hdf5::count_read(size * sizeof(coeff_t));
+}
+
+template <class coeff_t>
+void FileH5::read_hyperslab(std::string field,
+                            std::vector<hsize_t> const &offset,
+                            std::vector<hsize_t> const &count,
+                            Tensor<coeff_t> &block) const {
+  if (!defined(field)) {
+    auto msg = std::string("Lime error: field not found while "
+                           "trying to read: ") +
+               field;
+    throw std::runtime_error(msg);
+  }
+  auto scope = field_scope(field);
+  block.resize(std::vector<int64_t>(count.begin(), count.end()));
+  lime::hdf5::read_hyperslab(file_id_, field,
+                             hdf5::hdf5_datatype<coeff_t>(), offset, count,
+                             block.data());
+  hdf5::count_read(block.size() * sizeof(coeff_t));
+}
+
+template <class coeff_t>
+void FileH5::read_member(std::string field, std::string member,
+                         std::vector<coeff_t> &values) const {
+  if (!defined(field) || (type(field) != "Record")) {
+    auto msg = std::string("Lime error: record field not found while "
+                           "trying to read member: ") +
+               field;
+    throw std::runtime_error(msg);
+  }
+  auto scope = field_scope(field);
+  lime::hdf5::read_member(
+      file_id_, field, member, hdf5::hdf5_datatype<coeff_t>(),
+      [&values](hsize_t size, std::vector<hsize_t> const &) {
+        values.resize(size);
+      },
+      [&values](hsize_t idx) -> void * { return values.data() + idx; });
+  hdf5::count_read(values.size() * sizeof(coeff_t));
+}
+
+template <class data_t>
+void FileH5::write(std::string field, data_t const &data, bool force) {
+  auto scope = field_scope(field, true);
+  if (iomode_ == "r") {
+    throw std::runtime_error("Lime error: cannot write in read mode");
+  } else {
+    // Try to write to existing field
+    if (defined(field)) {
+      // Write to existing field if possible
+      if (force) {
+        // Throw error if field is extensible
+        if (extensible(field)) {
+          auto msg = std::string("Lime error: can't write to "
+                                 "extensible field. "
+                                 "Must be appended");
+          throw std::runtime_error(msg);
+        }
+
+        // Write to field if type/shape agree
+        if (lime::hdf5::write_compatible(file_id_, field, data) &&
+            packed_compatible(field, data)) {
+          lime::hdf5::write_static_field(file_id_, field, data);
+          hdf5::count_write(entry_bytes(data));
+        }
+
+        // Type/shape don't agree -> throw error
+        else {
+          auto msg = std::string("Lime error: can't write to "
+                                 "field. Incompatible type/shape");
+          throw std::runtime_error(msg);
+        }
+      }
+
+      // Throw error if field already defined
+      else {
+        auto msg = std::string("Lime error: can't write to already "
+                               "existing field. Use parameter "
+                               "force=true to overwrite");
+        throw std::runtime_error(msg);
+      }
+    }
+    // Create new field and write
+    else {
+      fields_.push_back(field);
+      std::string field_type = type_string(data);
+      field_types_[field] = field_type;
+      field_extensible_[field] = false;
+      lime::hdf5::create_static_field(file_id_, field, data, storage(field));
+      set_attributes(field, {{LIME_FIELD_TYPE_STRING, field_type},
+                             {LIME_FIELD_STATIC_EXTENSIBLE_STRING, "Static"}});
+      set_packed(field, data);
+      lime::hdf5::write_static_field(file_id_, field, data);
+      hdf5::count_write(entry_bytes(data));
+    }
+  }
+}
+
+template <class data_t>
+void FileH5::append(std::string field, data_t const &data) {
+  append(field, &data, 1);
+}
+
+template <class data_t>
+void FileH5::append(std::string field, std::vector<data_t> const &data) {
+  append(field, data.data(), (long)data.size());
+}
+
+template <class data_t>
+void FileH5::append(std::string field, data_t const *entries,
+                    long n_entries) {
+  auto scope = field_scope(field, true);
+  if (iomode_ == "r")
+    throw std::runtime_error("Lime error: cannot append in read mode");
+  else if (n_entries <= 0)
+    return;
+  else {
+    // Entries appended at once need to have the same shape
+    using traits = field_traits<data_t>;
+    auto shape = traits::shape(entries[0]);
+    for (long idx = 1; idx < n_entries; ++idx) {
+      bool same = (traits::shape(entries[idx]) == shape);
+      if constexpr (traits::packed)
+        same = same && (traits::bit_count(entries[idx]) ==
+                        traits::bit_count(entries[0]));
+      if (!same) {
+        auto msg = std::string("Lime error: can't append entries of "
+                               "different shape at once");
+        throw std::runtime_error(msg);
+      }
+    }
+
+    // Try to write to existing field
+    if (defined(field)) {
+      // Throw error if field is not extensible
+      if (!extensible(field)) {
+        auto msg = std::string("Lime error: can't append to "
+                               "non-extensible field.");
+        throw std::runtime_error(msg);
+      }
+      if (!appendable(field)) {
+        auto msg = std::string("Lime error: can't append to field. Field is "
+                               "not extensible after contiguous repack: ") +
+                   field;
+        throw std::runtime_error(msg);
+      }
+
+      // Write to field if type/shape agree
+      if (lime::hdf5::append_compatible(file_id_, field, entries[0]) &&
+          packed_compatible(field, entries[0])) {
+        lime::hdf5::append_extensible_field(file_id_, field, entries,
+                                            (hsize_t)n_entries);
+        hdf5::count_append(n_entries, n_entries * entry_bytes(entries[0]));
+      }
+
+      // Type/shape don't agree -> throw error
+      else {
+        auto msg = std::string("Lime error: can't append to "
+                               "field. Incompatible type/shape");
+        throw std::runtime_error(msg);
+      }
+    }
+    // Create new field and append
+    else {
+      fields_.push_back(field);
+      std::string field_type = type_string(entries[0]);
+      field_types_[field] = field_type;
+      field_extensible_[field] = true;
+      lime::hdf5::create_extensible_field(
+          file_id_, field, entries[0],
+          hdf5::default_chunk_size(field_traits<data_t>::rank),
+          storage(field));
+      set_attributes(field,
+                     {{LIME_FIELD_TYPE_STRING, field_type},
+                      {LIME_FIELD_STATIC_EXTENSIBLE_STRING, "Extensible"}});
+      set_packed(field, entries[0]);
+      lime::hdf5::append_extensible_field(file_id_, field, entries,
+                                          (hsize_t)n_entries);
+      hdf5::count_append(n_entries, n_entries * entry_bytes(entries[0]));
+    }
+  }
+}
+
+// Templates of FileH5Handler need the full definition of FileH5
+template <class data_t> void FileH5Handler::read(data_t &data) {
+  fileh5_->read(field_, data);
+}
+
+template <class data_t> void FileH5Handler::read(std::vector<data_t> &data) {
+  fileh5_->read(field_, data);
+}
+
+template <class data_t> void FileH5Handler::read(long idx, data_t &data) {
+  fileh5_->read(field_, idx, data);
+}
+
+template <class coeff_t>
+void FileH5Handler::read_into(coeff_t *buffer, long size) {
+  fileh5_->read_into(field_, buffer, size);
+}
+
+template <class coeff_t>
+void FileH5Handler::read_into(long idx, coeff_t *buffer, long size) {
+  fileh5_->read_into(field_, idx, buffer, size);
+}
+
+template <class coeff_t>
+void FileH5Handler::read_member(std::string member,
+                                std::vector<coeff_t> &values) {
+  fileh5_->read_member(field_, member, values);
+}
+
+template <class value_t, class>
+void FileH5Handler::set_attribute(std::string attribute_name,
+                                  value_t const &value) {
+  fileh5_->set_attribute(field_, attribute_name, value);
+}
+
+template <class value_t>
+void FileH5Handler::attribute(std::string attribute_name, value_t &value) {
+  fileh5_->attribute(field_, attribute_name, value);
+}
+
+template <class data_t> void FileH5Handler::operator<<(data_t const &data) {
+  fileh5_->append(field_, data);
+}
+
+template <class data_t> void FileH5Handler::operator=(data_t const &data) {
+  fileh5_->write(field_, data);
+}
+
 } // namespace lime
 
 #endif
@@ -20,6 +20,9 @@
 #include <string>
 #include <vector>
 
+#include <lime/attribute_traits.h>
+#include <lime/field_storage.h>
+
 namespace lime {
 
 class FileH5;
@@ -36,15 +39,30 @@ public:
   bool defined();
   std::string type();
   bool extensible();
+  long size();
 
   template <class data_t> void read(data_t &data);
   template <class data_t> void read(std::vector<data_t> &data);
+  template <class data_t> void read(long idx, data_t &data);
+  template <class coeff_t> void read_into(coeff_t *buffer, long size);
+  template <class coeff_t>
+  void read_into(long idx, coeff_t *buffer, long size);
+  template <class coeff_t>
+  void read_member(std::string member, std::vector<coeff_t> &values);
   template <class data_t> void operator<<(data_t const &data);
   template <class data_t> void operator=(data_t const &data);
 
   std::string attribute(std::string attribute_name);
   bool has_attribute(std::string attribute_name);
   void set_attribute(std::string attribute_name, std::string attribute_value);
+  template <class value_t,
+            class = std::enable_if_t<typed_attribute<value_t>>>
+  void set_attribute(std::string attribute_name, value_t const &value);
+  template <class value_t>
+  void attribute(std::string attribute_name, value_t &value);
+  std::map<std::string, std::string> attributes();
+  void set_attributes(std::map<std::string, std::string> const &attributes);
+  void set_storage(FieldStorage const &storage);
 
 private:
   std::string field_;
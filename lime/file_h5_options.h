@@ -0,0 +1,61 @@
+// Copyright 2020 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIME_FILE_H5_OPTIONS_H
+#define LIME_FILE_H5_OPTIONS_H
+
+#include <cstddef>
+#include <hdf5.h>
+
+namespace lime {
+
+// File creation and access properties of a FileH5. The defaults are the
+// hdf5 defaults. Options which only apply when creating a file (paged
+// aggregation, page size) are ignored when opening an existing file.
+struct FileH5Options {
+  // Newest file format, e.g. faster indexing of extensible fields. Files
+  // can only be read by hdf5 versions supporting the format.
+  bool latest_format = false;
+
+  // Objects of at least alignment_threshold bytes start at multiples of
+  // alignment bytes, e.g. the stripe size of a parallel filesystem
+  hsize_t alignment = 1;
+  hsize_t alignment_threshold = 1;
+
+  // Paged aggregation of file space (metadata and raw data in pages of
+  // page_size bytes, 0: hdf5 default). Paged files can be accessed through
+  // a page buffer of page_buffer_bytes (0: no page buffer).
+  bool paged_aggregation = false;
+  hsize_t page_size = 0;
+  size_t page_buffer_bytes = 0;
+
+  // Minimal size of metadata blocks in bytes (0: hdf5 default)
+  hsize_t meta_block_size = 0;
+
+  // Initial size of the metadata cache in bytes (0: hdf5 default), the
+  // cache still adapts its size between its bounds
+  size_t metadata_cache_bytes = 0;
+
+  // File held in memory by the hdf5 core driver, growing in increments of
+  // memory_increment bytes. With backing_store the file is read from disk
+  // when opened and written to disk in one go when closed, without it the
+  // file is scratch and never touches the disk.
+  bool in_memory = false;
+  bool backing_store = true;
+  size_t memory_increment = 1 << 20;
+};
+
+} // namespace lime
+
+#endif
@@ -15,49 +15,31 @@
 #ifndef LIME_HDF5_APPEND_COMPATIBLE_H
 #define LIME_HDF5_APPEND_COMPATIBLE_H
 
-#include <complex>
 #include <hdf5.h>
 #include <string>
+#include <vector>
 
-#include <lila/all.h>
-#include <lime/hdf5/types.h>
+#include <lime/field_traits.h>
 
 namespace lime {
 namespace hdf5 {
 
-// Functions to check field with a scalar entry
-bool append_compatible(hid_t file_id, std::string field, lime_int data);
-bool append_compatible(hid_t file_id, std::string field, lime_uint data);
-bool append_compatible(hid_t file_id, std::string field, lime_long data);
-bool append_compatible(hid_t file_id, std::string field, lime_ulong data);
-bool append_compatible(hid_t file_id, std::string field, lime_llong data);
-bool append_compatible(hid_t file_id, std::string field, lime_ullong data);
+// Function to check field with entries of given datatype and stored dims
+bool append_compatible(hid_t file_id, std::string field, hid_t datatype_id,
+                       std::vector<hsize_t> const &entry_dims);
 
-bool append_compatible(hid_t file_id, std::string field, lime_float data);
-bool append_compatible(hid_t file_id, std::string field, lime_double data);
-bool append_compatible(hid_t file_id, std::string field, lime_scomplex data);
-bool append_compatible(hid_t file_id, std::string field, lime_complex data);
+// Function to check field with entries of given datatype and shape
+bool append_compatible(hid_t file_id, std::string field, hid_t datatype_id,
+                       std::vector<hsize_t> const &shape, bool colmajor);
 
-// Functions to check a field with a lila::Vector entry
-bool append_compatible(hid_t file_id, std::string field,
-                       lila::Vector<lime_float> const &data);
-bool append_compatible(hid_t file_id, std::string field,
-                       lila::Vector<lime_double> const &data);
-bool append_compatible(hid_t file_id, std::string field,
-                       lila::Vector<lime_scomplex> const &data);
-bool append_compatible(hid_t file_id, std::string field,
-                       lila::Vector<lime_complex> const &data);
+template <class data_t>
+inline bool append_compatible(hid_t file_id, std::string field,
+                              data_t const &data) {
+  using traits = field_traits<data_t>;
+  return append_compatible(file_id, field, field_datatype<data_t>(),
+                           traits::shape(data), traits::column_major);
+}
 
-// Functions to check a field with a lila::Matrix entry
-bool append_compatible(hid_t file_id, std::string field,
-                       lila::Matrix<lime_float> const &data);
-bool append_compatible(hid_t file_id, std::string field,
-                       lila::Matrix<lime_double> const &data);
-bool append_compatible(hid_t file_id, std::string field,
-                       lila::Matrix<lime_scomplex> const &data);
-bool append_compatible(hid_t file_id, std::string field,
-                       lila::Matrix<lime_complex> const &data);
-  
 } // namespace hdf5
 } // namespace lime
 
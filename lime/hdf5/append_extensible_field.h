@@ -15,52 +15,45 @@
 #ifndef LIME_HDF5_APPEND_EXTENSIBLE_FIELD_H
 #define LIME_HDF5_APPEND_EXTENSIBLE_FIELD_H
 
-#include <complex>
 #include <hdf5.h>
 #include <string>
+#include <vector>
 
-#include <lila/all.h>
-#include <lime/hdf5/types.h>
+#include <lime/field_traits.h>
+#include <lime/hdf5/utils.h>
 
 namespace lime {
 namespace hdf5 {
 
-// Functions to write a field with a scalar entry
-void append_extensible_field(hid_t file_id, std::string field, lime_int data);
-void append_extensible_field(hid_t file_id, std::string field, lime_uint data);
-void append_extensible_field(hid_t file_id, std::string field, lime_long data);
-void append_extensible_field(hid_t file_id, std::string field, lime_ulong data);
-void append_extensible_field(hid_t file_id, std::string field, lime_llong data);
-void append_extensible_field(hid_t file_id, std::string field,
-                             lime_ullong data);
-
-void append_extensible_field(hid_t file_id, std::string field, lime_float data);
-void append_extensible_field(hid_t file_id, std::string field,
-                             lime_double data);
-void append_extensible_field(hid_t file_id, std::string field,
-                             lime_scomplex data);
-void append_extensible_field(hid_t file_id, std::string field,
-                             lime_complex data);
-
-// Functions to write a field with a lila::Vector entry
-void append_extensible_field(hid_t file_id, std::string field,
-                             lila::Vector<lime_float> const &data);
-void append_extensible_field(hid_t file_id, std::string field,
-                             lila::Vector<lime_double> const &data);
-void append_extensible_field(hid_t file_id, std::string field,
-                             lila::Vector<lime_scomplex> const &data);
-void append_extensible_field(hid_t file_id, std::string field,
-                             lila::Vector<lime_complex> const &data);
-
-// Functions to write a field with a lila::Matrix entry
-void append_extensible_field(hid_t file_id, std::string field,
-                             lila::Matrix<lime_float> const &data);
-void append_extensible_field(hid_t file_id, std::string field,
-                             lila::Matrix<lime_double> const &data);
-void append_extensible_field(hid_t file_id, std::string field,
-                             lila::Matrix<lime_scomplex> const &data);
-void append_extensible_field(hid_t file_id, std::string field,
-                             lila::Matrix<lime_complex> const &data);
+// Function to append an entry of given datatype to an extensible field
+void append_extensible_field(hid_t file_id, std::string field,
+                             hid_t datatype_id, const void *buffer,
+                             bool colmajor);
+
+// Function to append several entries of the same shape at once
+void append_extensible_field(hid_t file_id, std::string field,
+                             hid_t datatype_id, ConstEntryPointer const &entry,
+                             hsize_t n_entries, bool colmajor);
+
+template <class data_t>
+inline void append_extensible_field(hid_t file_id, std::string field,
+                                    data_t const &data) {
+  using traits = field_traits<data_t>;
+  append_extensible_field(file_id, field, field_datatype<data_t>(),
+                          traits::data(data), traits::column_major);
+}
+
+template <class data_t>
+inline void append_extensible_field(hid_t file_id, std::string field,
+                                    data_t const *entries, hsize_t n_entries) {
+  using traits = field_traits<data_t>;
+  append_extensible_field(
+      file_id, field, field_datatype<data_t>(),
+      [entries](hsize_t idx) -> const void * {
+        return traits::data(entries[idx]);
+      },
+      n_entries, traits::column_major);
+}
 
 } // namespace hdf5
 } // namespace lime
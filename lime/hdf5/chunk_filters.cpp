@@ -0,0 +1,170 @@
+#include "chunk_filters.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <zlib.h>
+
+#include <lime/hdf5/utils.h>
+
+namespace lime {
+namespace hdf5 {
+
+hsize_t chunk_entries(hid_t dataset_id) {
+  hid_t plist_id = H5Dget_create_plist(dataset_id);
+  hsize_t n_entries = 0;
+  if (H5Pget_layout(plist_id) == H5D_CHUNKED) {
+    auto dims = get_dataspace_dims(dataset_id);
+    std::vector<hsize_t> chunk_dims(dims.size());
+    if (H5Pget_chunk(plist_id, (int)dims.size(), chunk_dims.data()) ==
+        (int)dims.size()) {
+      bool whole = (dims.size() > 0);
+      for (size_t d = 1; whole && (d < dims.size()); ++d)
+        whole = (chunk_dims[d] == dims[d]);
+      if (whole)
+        n_entries = chunk_dims[0];
+    }
+  }
+  H5Pclose(plist_id);
+  return n_entries;
+}
+
+void complete_chunks(hsize_t offset, hsize_t n_entries, hsize_t chunk_size,
+                     hsize_t &first, hsize_t &last) {
+  first = last = offset;
+  if (chunk_size > 0) {
+    first = std::min((offset + chunk_size - 1) / chunk_size * chunk_size,
+                     offset + n_entries);
+    last = std::max(first, (offset + n_entries) / chunk_size * chunk_size);
+  }
+}
+
+bool direct_chunks(hid_t dataset_id, hid_t datatype_id,
+                   std::vector<ChunkFilter> &filters) {
+  hid_t stored_id = H5Dget_type(dataset_id);
+  bool direct = (H5Tequal(stored_id, datatype_id) > 0) &&
+                (H5Tdetect_class(datatype_id, H5T_VLEN) <= 0);
+  H5Tclose(stored_id);
+  if (!direct)
+    return false;
+
+  hid_t plist_id = H5Dget_create_plist(dataset_id);
+  int n_filters = H5Pget_nfilters(plist_id);
+  for (int idx = 0; direct && (idx < n_filters); ++idx) {
+    unsigned flags, values[8], config;
+    size_t n_values = 8;
+    H5Z_filter_t id = H5Pget_filter2(plist_id, (unsigned)idx, &flags,
+                                     &n_values, values, 0, NULL, &config);
+    unsigned parameter = (n_values > 0) ? values[0] : 0;
+    if ((id == H5Z_FILTER_SHUFFLE) && (parameter == 0))
+      filters.push_back({id, (unsigned)H5Tget_size(datatype_id)});
+    else if ((id == H5Z_FILTER_SHUFFLE) || (id == H5Z_FILTER_DEFLATE))
+      filters.push_back({id, parameter});
+    else
+      direct = false;
+  }
+  H5Pclose(plist_id);
+  return direct;
+}
+
+static void shuffle(const char *source, char *target, size_t nbytes,
+                    size_t type_size, bool inverse) {
+  size_t n_elements = nbytes / type_size;
+  for (size_t byte = 0; byte < type_size; ++byte)
+    for (size_t idx = 0; idx < n_elements; ++idx)
+      if (inverse)
+        target[idx * type_size + byte] = source[byte * n_elements + idx];
+      else
+        target[byte * n_elements + idx] = source[idx * type_size + byte];
+  std::memcpy(target + n_elements * type_size,
+              source + n_elements * type_size, nbytes % type_size);
+}
+
+bool filter_chunk(const char *chunk, size_t nbytes,
+                  std::vector<ChunkFilter> const &filters,
+                  std::vector<char> &filtered) {
+  filtered.assign(chunk, chunk + nbytes);
+  std::vector<char> buffer;
+  for (auto const &filter : filters) {
+    if (filter.id == H5Z_FILTER_SHUFFLE) {
+      buffer.resize(filtered.size());
+      shuffle(filtered.data(), buffer.data(), filtered.size(),
+              std::max(1u, filter.parameter), false);
+    } else {
+      uLongf size = compressBound((uLong)filtered.size());
+      buffer.resize(size);
+      if (compress2((Bytef *)buffer.data(), &size,
+                    (const Bytef *)filtered.data(), (uLong)filtered.size(),
+                    (int)filter.parameter) != Z_OK)
+        return false;
+      buffer.resize(size);
+    }
+    std::swap(filtered, buffer);
+  }
+  return true;
+}
+
+bool unfilter_chunk(std::vector<char> &stored, uint32_t filter_mask,
+                    std::vector<ChunkFilter> const &filters, char *chunk,
+                    size_t nbytes) {
+  // Every filter of lime's pipelines keeps the size except deflate, whose
+  // output is the chunk or its shuffled bytes
+  std::vector<char> buffer;
+  for (size_t idx = filters.size(); idx-- > 0;) {
+    if (filter_mask & (1u << idx))
+      continue;
+    buffer.resize(nbytes);
+    if (filters[idx].id == H5Z_FILTER_SHUFFLE) {
+      if (stored.size() != nbytes)
+        return false;
+      shuffle(stored.data(), buffer.data(), nbytes,
+              std::max(1u, filters[idx].parameter), true);
+    } else {
+      uLongf size = (uLongf)nbytes;
+      if ((uncompress((Bytef *)buffer.data(), &size,
+                      (const Bytef *)stored.data(),
+                      (uLong)stored.size()) != Z_OK) ||
+          (size != nbytes))
+        return false;
+    }
+    std::swap(stored, buffer);
+  }
+  if (stored.size() != nbytes)
+    return false;
+  std::memcpy(chunk, stored.data(), nbytes);
+  return true;
+}
+
+bool for_each_chunk(hsize_t n, size_t chunk_bytes,
+                    std::function<bool(hsize_t)> const &f) {
+  // Threads are only started if each has enough work to pay off
+  unsigned n_threads = LIME_FILTER_THREADS;
+  if (n_threads == 0)
+    n_threads = std::max(1u, std::thread::hardware_concurrency());
+  hsize_t n_busy = (hsize_t)n * chunk_bytes / LIME_FILTER_THREAD_BYTES;
+  n_threads = (unsigned)std::min({(hsize_t)n_threads, n, n_busy});
+  if (n_threads <= 1) {
+    for (hsize_t idx = 0; idx < n; ++idx)
+      if (!f(idx))
+        return false;
+    return true;
+  }
+
+  std::atomic<bool> failed(false);
+  auto run = [&](unsigned thread) {
+    for (hsize_t idx = thread; idx < n; idx += n_threads)
+      if (!f(idx))
+        failed = true;
+  };
+  std::vector<std::thread> threads;
+  for (unsigned thread = 1; thread < n_threads; ++thread)
+    threads.emplace_back(run, thread);
+  run(0);
+  for (auto &thread : threads)
+    thread.join();
+  return !failed;
+}
+
+} // namespace hdf5
+} // namespace lime
@@ -0,0 +1,77 @@
+// Copyright 2020 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIME_HDF5_CHUNK_FILTERS_H
+#define LIME_HDF5_CHUNK_FILTERS_H
+
+#include <functional>
+#include <hdf5.h>
+#include <vector>
+
+// Number of threads (de)compressing chunks, 0: one per core
+#ifndef LIME_FILTER_THREADS
+#define LIME_FILTER_THREADS 0
+#endif
+
+// Minimal number of bytes (de)compressed per thread, smaller amounts are
+// filtered by the calling thread alone
+#ifndef LIME_FILTER_THREAD_BYTES
+#define LIME_FILTER_THREAD_BYTES (4 << 20)
+#endif
+
+namespace lime {
+namespace hdf5 {
+
+// Filter of the pipeline of a dataset which lime applies itself
+struct ChunkFilter {
+  H5Z_filter_t id;
+  unsigned parameter; // element size of shuffle, level of deflate
+};
+
+// Number of entries per chunk of a dataset whose chunks cover whole
+// entries, 0 otherwise
+hsize_t chunk_entries(hid_t dataset_id);
+
+// Range [first, last) of the complete chunks among n_entries entries from
+// offset, empty if chunk_size is 0
+void complete_chunks(hsize_t offset, hsize_t n_entries, hsize_t chunk_size,
+                     hsize_t &first, hsize_t &last);
+
+// Whether raw chunks of a dataset can be written/read directly for
+// entries of given datatype, i.e. the datatype is stored without
+// conversion and all filters (in pipeline order) are shuffle/deflate
+bool direct_chunks(hid_t dataset_id, hid_t datatype_id,
+                   std::vector<ChunkFilter> &filters);
+
+// Apply the filters to a chunk as the hdf5 filter pipeline would
+bool filter_chunk(const char *chunk, size_t nbytes,
+                  std::vector<ChunkFilter> const &filters,
+                  std::vector<char> &filtered);
+
+// Undo the filters of a stored chunk, except those skipped in filter_mask,
+// into chunk of nbytes
+bool unfilter_chunk(std::vector<char> &stored, uint32_t filter_mask,
+                    std::vector<ChunkFilter> const &filters, char *chunk,
+                    size_t nbytes);
+
+// Call f(idx) for n chunks of chunk_bytes on at most LIME_FILTER_THREADS
+// threads, each filtering at least LIME_FILTER_THREAD_BYTES. False if f
+// failed for any idx.
+bool for_each_chunk(hsize_t n, size_t chunk_bytes,
+                    std::function<bool(hsize_t)> const &f);
+
+} // namespace hdf5
+} // namespace lime
+
+#endif
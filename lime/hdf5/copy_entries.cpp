@@ -0,0 +1,53 @@
+#include "copy_entries.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <lime/hdf5/utils.h>
+#include <lime/hdf5/write_entries.h>
+
+namespace lime {
+namespace hdf5 {
+
+void copy_entries(hid_t source_id, hid_t target_id, hsize_t source_start,
+                  hsize_t target_start, hsize_t count, hsize_t buffer_bytes) {
+  auto dims = get_dataspace_dims(source_id);
+  if ((dims.size() == 0) || (count == 0))
+    return;
+
+  hid_t datatype_id = H5Dget_type(source_id);
+  hsize_t entry_bytes = H5Tget_size(datatype_id);
+  for (std::size_t d = 1; d < dims.size(); ++d)
+    entry_bytes *= dims[d];
+  hsize_t block_size = std::max((hsize_t)1, buffer_bytes / entry_bytes);
+
+  // Blocks of whole chunks of the target are written directly
+  hsize_t chunk_size = chunk_entries(target_id);
+  if ((chunk_size > 0) && (block_size >= chunk_size))
+    block_size = block_size / chunk_size * chunk_size;
+  block_size = std::min(block_size, count);
+  std::vector<char> buffer(block_size * entry_bytes);
+
+  for (hsize_t start = 0; start < count; start += block_size) {
+    std::vector<hsize_t> source_offset(dims.size(), 0);
+    std::vector<hsize_t> block_dims = dims;
+    source_offset[0] = source_start + start;
+    block_dims[0] = std::min(block_size, count - start);
+
+    hid_t memspace_id =
+        H5Screate_simple((int)block_dims.size(), block_dims.data(), NULL);
+    hid_t source_space_id = H5Dget_space(source_id);
+    H5Sselect_hyperslab(source_space_id, H5S_SELECT_SET, source_offset.data(),
+                        NULL, block_dims.data(), NULL);
+    H5Dread(source_id, datatype_id, memspace_id, source_space_id, H5P_DEFAULT,
+            buffer.data());
+    write_entries(target_id, datatype_id, target_start + start,
+                  block_dims[0], buffer.data());
+    H5Sclose(source_space_id);
+    H5Sclose(memspace_id);
+  }
+  H5Tclose(datatype_id);
+}
+
+} // namespace hdf5
+} // namespace lime
@@ -0,0 +1,32 @@
+// Copyright 2018 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef LIME_HDF5_COPY_ENTRIES_H
+#define LIME_HDF5_COPY_ENTRIES_H
+
+#include <hdf5.h>
+
+namespace lime {
+namespace hdf5 {
+
+// Copy count entries (slices along the first dimension) from a source to a
+// target dataset of the same type, in blocks of at most buffer_bytes
+void copy_entries(hid_t source_id, hid_t target_id, hsize_t source_start,
+                  hsize_t target_start, hsize_t count, hsize_t buffer_bytes);
+
+} // namespace hdf5
+} // namespace lime
+
+#endif
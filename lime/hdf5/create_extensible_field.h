@@ -15,12 +15,9 @@
 #ifndef LIME_HDF5_CREATE_EXTENSIBLE_FIELD_H
 #define LIME_HDF5_CREATE_EXTENSIBLE_FIELD_H
 
-#include <complex>
 #include <hdf5.h>
 #include <string>
-
-#include <lila/all.h>
-#include <lime/hdf5/types.h>
+#include <vector>
 
 #ifndef LIME_STRING_CHUNK_SIZE
 #define LIME_STRING_CHUNK_SIZE 10
@@ -34,62 +31,47 @@
 #ifndef LIME_MATRIX_CHUNK_SIZE
 #define LIME_MATRIX_CHUNK_SIZE 1
 #endif
+#ifndef LIME_TENSOR_CHUNK_SIZE
+#define LIME_TENSOR_CHUNK_SIZE 1
+#endif
+
+#include <lime/field_storage.h>
+#include <lime/field_traits.h>
 
 namespace lime {
 namespace hdf5 {
 
-// Functions to create a field with a scalar entry
-void create_extensible_field(hid_t file_id, std::string field, lime_int data,
-                             hsize_t chunk_size = LIME_SCALAR_CHUNK_SIZE);
-void create_extensible_field(hid_t file_id, std::string field, lime_uint data,
-                             hsize_t chunk_size = LIME_SCALAR_CHUNK_SIZE);
-void create_extensible_field(hid_t file_id, std::string field, lime_long data,
-                             hsize_t chunk_size = LIME_SCALAR_CHUNK_SIZE);
-void create_extensible_field(hid_t file_id, std::string field, lime_ulong data,
-                             hsize_t chunk_size = LIME_SCALAR_CHUNK_SIZE);
-void create_extensible_field(hid_t file_id, std::string field, lime_llong data,
-                             hsize_t chunk_size = LIME_SCALAR_CHUNK_SIZE);
-void create_extensible_field(hid_t file_id, std::string field, lime_ullong data,
-                             hsize_t chunk_size = LIME_SCALAR_CHUNK_SIZE);
+inline hsize_t default_chunk_size(int rank) {
+  switch (rank) {
+  case 0:
+    return LIME_SCALAR_CHUNK_SIZE;
+  case 1:
+    return LIME_VECTOR_CHUNK_SIZE;
+  case 2:
+    return LIME_MATRIX_CHUNK_SIZE;
+  default:
+    return LIME_TENSOR_CHUNK_SIZE;
+  }
+}
 
-void create_extensible_field(hid_t file_id, std::string field, lime_float data,
-                             hsize_t chunk_size = LIME_SCALAR_CHUNK_SIZE);
-void create_extensible_field(hid_t file_id, std::string field, lime_double data,
-                             hsize_t chunk_size = LIME_SCALAR_CHUNK_SIZE);
-void create_extensible_field(hid_t file_id, std::string field,
-                             lime_scomplex data,
-                             hsize_t chunk_size = LIME_SCALAR_CHUNK_SIZE);
+// Function to create an extensible field with entries of given datatype/shape
 void create_extensible_field(hid_t file_id, std::string field,
-                             lime_complex data,
-                             hsize_t chunk_size = LIME_SCALAR_CHUNK_SIZE);
+                             hid_t datatype_id,
+                             std::vector<hsize_t> const &shape, bool colmajor,
+                             hsize_t chunk_size,
+                             FieldStorage const &storage = FieldStorage());
 
-// Functions to create a field with a lila::Vector entry
-void create_extensible_field(hid_t file_id, std::string field,
-                             lila::Vector<lime_float> const &data,
-                             hsize_t chunk_size = LIME_VECTOR_CHUNK_SIZE);
-void create_extensible_field(hid_t file_id, std::string field,
-                             lila::Vector<lime_double> const &data,
-                             hsize_t chunk_size = LIME_VECTOR_CHUNK_SIZE);
-void create_extensible_field(hid_t file_id, std::string field,
-                             lila::Vector<lime_scomplex> const &data,
-                             hsize_t chunk_size = LIME_VECTOR_CHUNK_SIZE);
-void create_extensible_field(hid_t file_id, std::string field,
-                             lila::Vector<lime_complex> const &data,
-                             hsize_t chunk_size = LIME_VECTOR_CHUNK_SIZE);
-
-// Functions to create a field with a lila::Matrix entry
-void create_extensible_field(hid_t file_id, std::string field,
-                             lila::Matrix<lime_float> const &data,
-                             hsize_t chunk_size = LIME_MATRIX_CHUNK_SIZE);
-void create_extensible_field(hid_t file_id, std::string field,
-                             lila::Matrix<lime_double> const &data,
-                             hsize_t chunk_size = LIME_MATRIX_CHUNK_SIZE);
-void create_extensible_field(hid_t file_id, std::string field,
-                             lila::Matrix<lime_scomplex> const &data,
-                             hsize_t chunk_size = LIME_MATRIX_CHUNK_SIZE);
-void create_extensible_field(hid_t file_id, std::string field,
-                             lila::Matrix<lime_complex> const &data,
-                             hsize_t chunk_size = LIME_MATRIX_CHUNK_SIZE);
+template <class data_t>
+inline void
+create_extensible_field(hid_t file_id, std::string field, data_t const &data,
+                        hsize_t chunk_size = default_chunk_size(
+                            field_traits<data_t>::rank),
+                        FieldStorage const &storage = FieldStorage()) {
+  using traits = field_traits<data_t>;
+  create_extensible_field(file_id, field, field_datatype<data_t>(),
+                          traits::shape(data), traits::column_major,
+                          chunk_size, storage);
+}
 
 } // namespace hdf5
 } // namespace lime
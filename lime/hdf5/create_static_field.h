@@ -15,48 +15,29 @@
 #ifndef LIME_HDF5_CREATE_STATIC_FIELD_H
 #define LIME_HDF5_CREATE_STATIC_FIELD_H
 
-#include <complex>
 #include <hdf5.h>
 #include <string>
+#include <vector>
 
-#include <lila/all.h>
-#include <lime/hdf5/types.h>
+#include <lime/field_storage.h>
+#include <lime/field_traits.h>
 
 namespace lime {
 namespace hdf5 {
 
-// Functions to create a field with a scalar entry
-void create_static_field(hid_t file_id, std::string field, lime_int data);
-void create_static_field(hid_t file_id, std::string field, lime_uint data);
-void create_static_field(hid_t file_id, std::string field, lime_long data);
-void create_static_field(hid_t file_id, std::string field, lime_ulong data);
-void create_static_field(hid_t file_id, std::string field, lime_llong data);
-void create_static_field(hid_t file_id, std::string field, lime_ullong data);
-
-void create_static_field(hid_t file_id, std::string field, lime_float data);
-void create_static_field(hid_t file_id, std::string field, lime_double data);
-void create_static_field(hid_t file_id, std::string field, lime_scomplex data);
-void create_static_field(hid_t file_id, std::string field, lime_complex data);
-
-// Functions to create a field with a lila::Vector entry
-void create_static_field(hid_t file_id, std::string field,
-                         lila::Vector<lime_float> data);
-void create_static_field(hid_t file_id, std::string field,
-                         lila::Vector<lime_double> data);
-void create_static_field(hid_t file_id, std::string field,
-                         lila::Vector<lime_scomplex> data);
-void create_static_field(hid_t file_id, std::string field,
-                         lila::Vector<lime_complex> data);
-
-// Functions to create a field with a lila::Matrix entry
-void create_static_field(hid_t file_id, std::string field,
-                         lila::Matrix<lime_float> data);
-void create_static_field(hid_t file_id, std::string field,
-                         lila::Matrix<lime_double> data);
-void create_static_field(hid_t file_id, std::string field,
-                         lila::Matrix<lime_scomplex> data);
-void create_static_field(hid_t file_id, std::string field,
-                         lila::Matrix<lime_complex> data);
+// Function to create a static field with an entry of given datatype/shape
+void create_static_field(hid_t file_id, std::string field, hid_t datatype_id,
+                         std::vector<hsize_t> const &shape, bool colmajor,
+                         FieldStorage const &storage = FieldStorage());
+
+template <class data_t>
+inline void create_static_field(hid_t file_id, std::string field,
+                                data_t const &data,
+                                FieldStorage const &storage = FieldStorage()) {
+  using traits = field_traits<data_t>;
+  create_static_field(file_id, field, field_datatype<data_t>(),
+                      traits::shape(data), traits::column_major, storage);
+}
 
 } // namespace hdf5
 } // namespace lime
@@ -0,0 +1,49 @@
+#include "field_scope.h"
+
+namespace lime {
+namespace hdf5 {
+
+static thread_local FieldScope const *active_scope_ = nullptr;
+
+FieldScope::FieldScope(hid_t file_id, std::string field, FieldStats *stats,
+                       hid_t dataset_id)
+    : file_id_(file_id), field_(field), stats_(stats), dataset_id_(dataset_id),
+      previous_(active_scope_) {
+  active_scope_ = this;
+}
+
+FieldScope::~FieldScope() { active_scope_ = previous_; }
+
+FieldStats *active_stats() {
+  return (active_scope_ == nullptr) ? nullptr : active_scope_->stats_;
+}
+
+hid_t open_dataset(hid_t file_id, std::string const &field) {
+  // Datasets kept open by FileH5 are shared, H5Dclose releases the reference
+  FieldScope const *scope = active_scope_;
+  bool same_field = (scope != nullptr) && (scope->file_id_ == file_id) &&
+                    (scope->field_ == field);
+  if (same_field && (scope->dataset_id_ >= 0)) {
+    H5Iinc_ref(scope->dataset_id_);
+    return scope->dataset_id_;
+  }
+  if (same_field && (scope->stats_ != nullptr))
+    ++scope->stats_->dataset_opens;
+  return H5Dopen2(file_id, field.c_str(), H5P_DEFAULT);
+}
+
+StatsTimer::StatsTimer(const char *helper)
+    : stats_(active_stats()), helper_(helper) {
+  if (stats_ != nullptr)
+    start_ = std::chrono::steady_clock::now();
+}
+
+StatsTimer::~StatsTimer() {
+  if (stats_ != nullptr)
+    stats_->seconds[helper_] += std::chrono::duration<double>(
+                                    std::chrono::steady_clock::now() - start_)
+                                    .count();
+}
+
+} // namespace hdf5
+} // namespace lime
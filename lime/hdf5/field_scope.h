@@ -0,0 +1,102 @@
+// Copyright 2020 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIME_HDF5_FIELD_SCOPE_H
+#define LIME_HDF5_FIELD_SCOPE_H
+
+#include <chrono>
+#include <cstddef>
+#include <hdf5.h>
+#include <string>
+
+#include <lime/io_stats.h>
+
+namespace lime {
+namespace hdf5 {
+
+// Context of the field FileH5 currently operates on in this thread: the
+// statistics of the field if they are collected, and the dataset of the
+// field if FileH5 keeps it open. Helpers access the field through
+// open_dataset, such that the chunk cache of a kept dataset is reused.
+// Fields of other files (or groups) are opened as usual.
+class FieldScope {
+public:
+  FieldScope(hid_t file_id, std::string field, FieldStats *stats,
+             hid_t dataset_id);
+  ~FieldScope();
+  FieldScope(FieldScope const &) = delete;
+  FieldScope &operator=(FieldScope const &) = delete;
+
+private:
+  hid_t file_id_;
+  std::string field_;
+  FieldStats *stats_;
+  hid_t dataset_id_;
+  FieldScope const *previous_;
+
+  friend FieldStats *active_stats();
+  friend hid_t open_dataset(hid_t file_id, std::string const &field);
+};
+
+// Statistics of the current field, nullptr if not collected
+FieldStats *active_stats();
+
+// Opens the dataset of a field, needs to be closed with H5Dclose
+hid_t open_dataset(hid_t file_id, std::string const &field);
+
+// Adds its lifetime to the time spent in a helper of the active statistics
+class StatsTimer {
+public:
+  explicit StatsTimer(const char *helper);
+  ~StatsTimer();
+  StatsTimer(StatsTimer const &) = delete;
+  StatsTimer &operator=(StatsTimer const &) = delete;
+
+private:
+  FieldStats *stats_;
+  const char *helper_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+inline void count_extent_change() {
+  if (FieldStats *stats = active_stats())
+    ++stats->extent_changes;
+}
+
+inline void count_read(size_t bytes) {
+  if (FieldStats *stats = active_stats()) {
+    ++stats->reads;
+    stats->bytes_read += (long)bytes;
+  }
+}
+
+inline void count_write(size_t bytes) {
+  if (FieldStats *stats = active_stats()) {
+    ++stats->writes;
+    stats->bytes_written += (long)bytes;
+  }
+}
+
+inline void count_append(long n_entries, size_t bytes) {
+  if (FieldStats *stats = active_stats()) {
+    ++stats->appends;
+    stats->entries_appended += n_entries;
+    stats->bytes_written += (long)bytes;
+  }
+}
+
+} // namespace hdf5
+} // namespace lime
+
+#endif
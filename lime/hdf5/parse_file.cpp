@@ -39,6 +39,7 @@ herr_t parse_file(hid_t loc_id, const char *name, const H5O_info_t *info,
 	    }
 	  else
 	    {
+	      H5Dclose(dataset_id);
 	      auto msg = std::string("Lime error: invalid field type in "
 				     "dataset.");
 	      throw std::runtime_error(msg);
@@ -61,14 +62,14 @@ herr_t parse_file(hid_t loc_id, const char *name, const H5O_info_t *info,
 	    }
 	  else
 	    {
+	      H5Dclose(dataset_id);
 	      auto msg = std::string("Lime error: invalid "
 				     "static/entensible "
 				     "descriptor in dataset.");
 	      throw std::runtime_error(msg);
 	    }
 	}
-
-
+      H5Dclose(dataset_id);
     }
   // if (name[0] == '.')         /* Root group */
   //   {
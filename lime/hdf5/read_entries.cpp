@@ -0,0 +1,110 @@
+#include "read_entries.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include <lime/hdf5/field_scope.h>
+#include <lime/hdf5/read_extensible_field.h>
+#include <lime/hdf5/utils.h>
+
+namespace lime {
+namespace hdf5 {
+
+namespace {
+
+void read_hyperslab(hid_t dataset_id, hid_t datatype_id, hsize_t offset,
+                    hsize_t n_entries, void *buffer) {
+  if (n_entries == 0)
+    return;
+  auto dims = get_dataspace_dims(dataset_id);
+  std::vector<hsize_t> start(dims.size(), 0);
+  start[0] = offset;
+  dims[0] = n_entries;
+  hid_t filespace_id = H5Dget_space(dataset_id);
+  H5Sselect_hyperslab(filespace_id, H5S_SELECT_SET, start.data(), NULL,
+                      dims.data(), NULL);
+  hid_t memspace_id = H5Screate_simple((int)dims.size(), dims.data(), NULL);
+  herr_t status = H5Dread(dataset_id, datatype_id, memspace_id,
+                          filespace_id, H5P_DEFAULT, buffer);
+  H5Sclose(memspace_id);
+  H5Sclose(filespace_id);
+  if (status < 0)
+    throw std::runtime_error("Lime error: can't read entries");
+}
+
+} // namespace
+
+void read_entries(hid_t dataset_id, hid_t datatype_id, hsize_t offset,
+                  hsize_t n_entries, void *buffer) {
+  StatsTimer timer("read_entries");
+  auto dims = get_dataspace_dims(dataset_id);
+  size_t entry_bytes = H5Tget_size(datatype_id);
+  for (size_t d = 1; d < dims.size(); ++d)
+    entry_bytes *= (size_t)dims[d];
+
+  // Only compressed chunks profit from being decompressed in parallel
+  hsize_t chunk_size = chunk_entries(dataset_id);
+  hsize_t first, last;
+  complete_chunks(offset, n_entries, chunk_size, first, last);
+  std::vector<ChunkFilter> filters;
+  if ((last - first < 2 * chunk_size) || (entry_bytes == 0) ||
+      !direct_chunks(dataset_id, datatype_id, filters) || filters.empty()) {
+    read_hyperslab(dataset_id, datatype_id, offset, n_entries, buffer);
+    return;
+  }
+
+  char *entries = (char *)buffer;
+  read_hyperslab(dataset_id, datatype_id, offset, first - offset, entries);
+
+  // hdf5 reads batches of raw chunks one after another (flushing chunks
+  // still in its cache), which are then decompressed in parallel into
+  // their place in the buffer
+  size_t chunk_bytes = chunk_size * entry_bytes;
+  hsize_t n_chunks = (last - first) / chunk_size;
+  hsize_t batch = std::max((hsize_t)1, LIME_READ_BUFFER_SIZE / chunk_bytes);
+  std::vector<std::vector<char>> stored(std::min(batch, n_chunks));
+  std::vector<uint32_t> filter_masks(stored.size());
+  std::vector<hsize_t> chunk_offset(dims.size(), 0);
+  for (hsize_t start = 0; start < n_chunks; start += batch) {
+    hsize_t count = std::min(batch, n_chunks - start);
+    bool allocated = true;
+    for (hsize_t chunk = 0; allocated && (chunk < count); ++chunk) {
+      chunk_offset[0] = first + (start + chunk) * chunk_size;
+      // Unallocated chunks are no error, they are read with fill values
+      hsize_t nbytes = 0;
+      herr_t status;
+      H5E_BEGIN_TRY {
+        status = H5Dget_chunk_storage_size(dataset_id, chunk_offset.data(),
+                                           &nbytes);
+      }
+      H5E_END_TRY;
+      allocated = (status >= 0) && (nbytes > 0);
+      if (allocated) {
+        stored[chunk].resize(nbytes);
+        if (H5Dread_chunk(dataset_id, H5P_DEFAULT, chunk_offset.data(),
+                          &filter_masks[chunk], stored[chunk].data()) < 0)
+          throw std::runtime_error("Lime error: can't read chunk");
+      }
+    }
+
+    // Chunks which were never written hold fill values
+    char *chunks =
+        entries + (first - offset + start * chunk_size) * entry_bytes;
+    if (!allocated)
+      read_hyperslab(dataset_id, datatype_id, first + start * chunk_size,
+                     count * chunk_size, chunks);
+    else if (!for_each_chunk(count, chunk_bytes, [&](hsize_t chunk) {
+               return unfilter_chunk(stored[chunk], filter_masks[chunk],
+                                     filters, chunks + chunk * chunk_bytes,
+                                     chunk_bytes);
+             }))
+      throw std::runtime_error("Lime error: can't decompress chunk");
+  }
+
+  read_hyperslab(dataset_id, datatype_id, last, offset + n_entries - last,
+                 entries + (last - offset) * entry_bytes);
+}
+
+} // namespace hdf5
+} // namespace lime
@@ -0,0 +1,36 @@
+// Copyright 2020 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIME_HDF5_READ_ENTRIES_H
+#define LIME_HDF5_READ_ENTRIES_H
+
+#include <hdf5.h>
+
+#include <lime/hdf5/chunk_filters.h>
+
+namespace lime {
+namespace hdf5 {
+
+// Read n_entries entries of a dataset starting at entry offset into a
+// contiguous buffer of given datatype. Complete compressed chunks are read
+// raw and decompressed on worker threads straight into the buffer if the
+// datatype is stored without conversion. Remaining entries are read
+// through H5Dread.
+void read_entries(hid_t dataset_id, hid_t datatype_id, hsize_t offset,
+                  hsize_t n_entries, void *buffer);
+
+} // namespace hdf5
+} // namespace lime
+
+#endif
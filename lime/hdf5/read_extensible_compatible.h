@@ -15,67 +15,26 @@
 #ifndef LIME_HDF5_READ_EXTENSIBLE_COMPATIBLE_H
 #define LIME_HDF5_READ_EXTENSIBLE_COMPATIBLE_H
 
-#include <complex>
 #include <hdf5.h>
 #include <string>
+#include <vector>
 
-#include <lila/all.h>
-#include <lime/hdf5/types.h>
+#include <lime/field_traits.h>
 
 namespace lime {
 namespace hdf5 {
 
-// Functions to check field with a scalar entry
+// Function to check an extensible field with entries of given datatype/rank
 bool read_extensible_compatible(hid_t file_id, std::string field,
-                                std::vector<lime_int> const &data);
-bool read_extensible_compatible(hid_t file_id, std::string field,
-                                std::vector<lime_uint> const &data);
-bool read_extensible_compatible(hid_t file_id, std::string field,
-                                std::vector<lime_long> const &data);
-bool read_extensible_compatible(hid_t file_id, std::string field,
-                                std::vector<lime_ulong> const &data);
-bool read_extensible_compatible(hid_t file_id, std::string field,
-                                std::vector<lime_llong> const &data);
-bool read_extensible_compatible(hid_t file_id, std::string field,
-                                std::vector<lime_ullong> const &data);
-
-bool read_extensible_compatible(hid_t file_id, std::string field,
-                                std::vector<lime_float> const &data);
-bool read_extensible_compatible(hid_t file_id, std::string field,
-                                std::vector<lime_double> const &data);
-bool read_extensible_compatible(hid_t file_id, std::string field,
-                                std::vector<lime_scomplex> const &data);
-bool read_extensible_compatible(hid_t file_id, std::string field,
-                                std::vector<lime_complex> const &data);
+                                hid_t datatype_id, int rank);
 
-// Functions to check a field with a lila::Vector entry
-bool read_extensible_compatible(
-    hid_t file_id, std::string field,
-    std::vector<lila::Vector<lime_float>> const &data);
-bool read_extensible_compatible(
-    hid_t file_id, std::string field,
-    std::vector<lila::Vector<lime_double>> const &data);
-bool read_extensible_compatible(
-    hid_t file_id, std::string field,
-    std::vector<lila::Vector<lime_scomplex>> const &data);
-bool read_extensible_compatible(
-    hid_t file_id, std::string field,
-    std::vector<lila::Vector<lime_complex>> const &data);
+template <class data_t>
+inline bool read_extensible_compatible(hid_t file_id, std::string field,
+                                       std::vector<data_t> const &data) {
+  return read_extensible_compatible(file_id, field, field_datatype<data_t>(),
+                                    field_traits<data_t>::rank);
+}
 
-// Functions to check a field with a lila::Matrix entry
-bool read_extensible_compatible(
-    hid_t file_id, std::string field,
-    std::vector<lila::Matrix<lime_float>> const &data);
-bool read_extensible_compatible(
-    hid_t file_id, std::string field,
-    std::vector<lila::Matrix<lime_double>> const &data);
-bool read_extensible_compatible(
-    hid_t file_id, std::string field,
-    std::vector<lila::Matrix<lime_scomplex>> const &data);
-bool read_extensible_compatible(
-    hid_t file_id, std::string field,
-    std::vector<lila::Matrix<lime_complex>> const &data);
-  
 } // namespace hdf5
 } // namespace lime
 
@@ -0,0 +1,45 @@
+#include "read_extensible_element.h"
+
+#include <lime/hdf5/field_scope.h>
+#include <lime/hdf5/utils.h>
+
+namespace lime {
+namespace hdf5 {
+
+void read_extensible_element(hid_t file_id, std::string field, hsize_t idx,
+                             hid_t datatype_id, bool colmajor,
+                             EntryAllocator const &allocate) {
+  StatsTimer timer("read_extensible_element");
+  hid_t dataset_id = open_dataset(file_id, field);
+  auto dims = get_dataspace_dims(dataset_id);
+  std::vector<hsize_t> entry_dims(dims.begin() + 1, dims.end());
+
+  hid_t filespace_id = H5Dget_space(dataset_id);
+  std::vector<hsize_t> offset(dims.size(), 0);
+  offset[0] = idx;
+  std::vector<hsize_t> ext_dims = dims;
+  ext_dims[0] = 1;
+  H5Sselect_hyperslab(filespace_id, H5S_SELECT_SET, offset.data(), NULL,
+                      ext_dims.data(), NULL);
+  hid_t memspace_id =
+      H5Screate_simple((int)ext_dims.size(), ext_dims.data(), NULL);
+
+  // Matrices of older files are stored row-major
+  if (colmajor && (entry_dims.size() == 2) && !column_major(dataset_id)) {
+    size_t nbytes = H5Tget_size(datatype_id);
+    std::vector<char> buffer(entry_dims[0] * entry_dims[1] * nbytes);
+    H5Dread(dataset_id, datatype_id, memspace_id, filespace_id, H5P_DEFAULT,
+            buffer.data());
+    transpose_entry(buffer.data(), (char *)allocate(entry_dims),
+                    entry_dims[0], entry_dims[1], nbytes);
+  } else
+    H5Dread(dataset_id, datatype_id, memspace_id, filespace_id, H5P_DEFAULT,
+            allocate(entry_shape(entry_dims, colmajor)));
+
+  H5Sclose(memspace_id);
+  H5Sclose(filespace_id);
+  H5Dclose(dataset_id);
+}
+
+} // namespace hdf5
+} // namespace lime
@@ -0,0 +1,49 @@
+// Copyright 2018 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIME_HDF5_READ_EXTENSIBLE_ELEMENT_H
+#define LIME_HDF5_READ_EXTENSIBLE_ELEMENT_H
+
+#include <hdf5.h>
+#include <string>
+#include <vector>
+
+#include <lime/hdf5/utils.h>
+#include <lime/field_traits.h>
+
+namespace lime {
+namespace hdf5 {
+
+// Function to read a single entry of an extensible field. The memory of the
+// entry is provided by allocate(shape) once its shape is known.
+void read_extensible_element(hid_t file_id, std::string field, hsize_t idx,
+                             hid_t datatype_id, bool colmajor,
+                             EntryAllocator const &allocate);
+
+template <class data_t>
+inline void read_extensible_element(hid_t file_id, std::string field,
+                                    hsize_t idx, data_t &data) {
+  using traits = field_traits<data_t>;
+  read_extensible_element(
+      file_id, field, idx, field_datatype<data_t>(), traits::column_major,
+      [&data](std::vector<hsize_t> const &shape) -> void * {
+        traits::resize(data, shape);
+        return traits::data(data);
+      });
+}
+
+} // namespace hdf5
+} // namespace lime
+
+#endif
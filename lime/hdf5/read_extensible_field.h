@@ -15,59 +15,43 @@
 #ifndef LIME_HDF5_READ_EXTENSIBLE_FIELD_H
 #define LIME_HDF5_READ_EXTENSIBLE_FIELD_H
 
-#include <complex>
 #include <hdf5.h>
 #include <string>
 #include <vector>
 
-#include <lila/all.h>
-#include <lime/hdf5/types.h>
+// Maximal size in bytes of the buffer entries are read to before they are
+// distributed to their memory
+#ifndef LIME_READ_BUFFER_SIZE
+#define LIME_READ_BUFFER_SIZE ((hsize_t)1 << 24)
+#endif
+
+#include <lime/hdf5/utils.h>
+#include <lime/field_traits.h>
 
 namespace lime {
 namespace hdf5 {
 
-// Functions to read a field with a scalar entry
-void read_extensible_field(hid_t file_id, std::string field,
-                           std::vector<lime_int> &data);
-void read_extensible_field(hid_t file_id, std::string field,
-                           std::vector<lime_uint> &data);
-void read_extensible_field(hid_t file_id, std::string field,
-                           std::vector<lime_long> &data);
-void read_extensible_field(hid_t file_id, std::string field,
-                           std::vector<lime_ulong> &data);
-void read_extensible_field(hid_t file_id, std::string field,
-                           std::vector<lime_llong> &data);
-void read_extensible_field(hid_t file_id, std::string field,
-                           std::vector<lime_ullong> &data);
-
-void read_extensible_field(hid_t file_id, std::string field,
-                           std::vector<lime_float> &data);
-void read_extensible_field(hid_t file_id, std::string field,
-                           std::vector<lime_double> &data);
-void read_extensible_field(hid_t file_id, std::string field,
-                           std::vector<lime_scomplex> &data);
-void read_extensible_field(hid_t file_id, std::string field,
-                           std::vector<lime_complex> &data);
-
-// Functions to read a field with a lila::Vector entry
-void read_extensible_field(hid_t file_id, std::string field,
-                           std::vector<lila::Vector<lime_float>> &data);
-void read_extensible_field(hid_t file_id, std::string field,
-                           std::vector<lila::Vector<lime_double>> &data);
-void read_extensible_field(hid_t file_id, std::string field,
-                           std::vector<lila::Vector<lime_scomplex>> &data);
-void read_extensible_field(hid_t file_id, std::string field,
-                           std::vector<lila::Vector<lime_complex>> &data);
-
-// Functions to read a field with a lila::Matrix entry
-void read_extensible_field(hid_t file_id, std::string field,
-                           std::vector<lila::Matrix<lime_float>> &data);
-void read_extensible_field(hid_t file_id, std::string field,
-                           std::vector<lila::Matrix<lime_double>> &data);
-void read_extensible_field(hid_t file_id, std::string field,
-                           std::vector<lila::Matrix<lime_scomplex>> &data);
-void read_extensible_field(hid_t file_id, std::string field,
-                           std::vector<lila::Matrix<lime_complex>> &data);
+// Function to read all entries of an extensible field with a single read.
+// resize(size, shape) has to provide memory for all entries, entry(idx)
+// returns the memory of a single entry.
+void read_extensible_field(hid_t file_id, std::string field,
+                           hid_t datatype_id, bool colmajor,
+                           EntriesAllocator const &resize,
+                           EntryPointer const &entry);
+
+template <class data_t>
+inline void read_extensible_field(hid_t file_id, std::string field,
+                                  std::vector<data_t> &data) {
+  using traits = field_traits<data_t>;
+  read_extensible_field(
+      file_id, field, field_datatype<data_t>(), traits::column_major,
+      [&data](hsize_t size, std::vector<hsize_t> const &shape) {
+        data.resize(size);
+        for (auto &entry : data)
+          traits::resize(entry, shape);
+      },
+      [&data](hsize_t idx) -> void * { return traits::data(data[idx]); });
+}
 
 } // namespace hdf5
 } // namespace lime
@@ -0,0 +1,55 @@
+#include "read_hyperslab.h"
+
+#include <stdexcept>
+
+#include <lime/hdf5/field_scope.h>
+#include <lime/hdf5/utils.h>
+
+namespace lime {
+namespace hdf5 {
+
+void read_hyperslab(hid_t file_id, std::string field, hid_t datatype_id,
+                    std::vector<hsize_t> const &offset,
+                    std::vector<hsize_t> const &count, void *buffer) {
+  StatsTimer timer("read_hyperslab");
+  hid_t dataset_id = open_dataset(file_id, field);
+
+  // Check if correct datatype
+  if (!datatype_compatible(dataset_id, datatype_id)) {
+    H5Dclose(dataset_id);
+    auto msg = std::string("Lime error: wrong entry type in hyperslab of "
+                           "field: ") +
+               field;
+    throw std::runtime_error(msg);
+  }
+
+  // Check if block is within the dataset
+  auto dims = get_dataspace_dims(dataset_id);
+  bool inside = (offset.size() == dims.size()) && (count.size() == dims.size());
+  for (size_t d = 0; inside && (d < dims.size()); ++d)
+    inside = (offset[d] <= dims[d]) && (count[d] <= dims[d] - offset[d]);
+  if (!inside) {
+    H5Dclose(dataset_id);
+    auto msg = std::string("Lime error: hyperslab out of range in field: ") +
+               field;
+    throw std::runtime_error(msg);
+  }
+
+  hsize_t size = 1;
+  for (auto c : count)
+    size *= c;
+  if (size > 0) {
+    hid_t filespace_id = H5Dget_space(dataset_id);
+    H5Sselect_hyperslab(filespace_id, H5S_SELECT_SET, offset.data(), NULL,
+                        count.data(), NULL);
+    hid_t memspace_id = H5Screate_simple((int)count.size(), count.data(), NULL);
+    H5Dread(dataset_id, datatype_id, memspace_id, filespace_id, H5P_DEFAULT,
+            buffer);
+    H5Sclose(memspace_id);
+    H5Sclose(filespace_id);
+  }
+  H5Dclose(dataset_id);
+}
+
+} // namespace hdf5
+} // namespace lime
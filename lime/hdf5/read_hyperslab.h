@@ -0,0 +1,34 @@
+// Copyright 2020 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIME_HDF5_READ_HYPERSLAB_H
+#define LIME_HDF5_READ_HYPERSLAB_H
+
+#include <hdf5.h>
+#include <string>
+#include <vector>
+
+namespace lime {
+namespace hdf5 {
+
+// Function to read a block with given offset and count in each dimension
+// of a dataset into buffer, the block is stored row-major
+void read_hyperslab(hid_t file_id, std::string field, hid_t datatype_id,
+                    std::vector<hsize_t> const &offset,
+                    std::vector<hsize_t> const &count, void *buffer);
+
+} // namespace hdf5
+} // namespace lime
+
+#endif
@@ -0,0 +1,65 @@
+#include "read_into.h"
+
+#include <stdexcept>
+
+#include <lime/hdf5/field_scope.h>
+#include <lime/hdf5/read_entries.h>
+#include <lime/hdf5/utils.h>
+
+namespace lime {
+namespace hdf5 {
+
+void read_into(hid_t file_id, std::string field, hid_t datatype_id,
+               long idx, void *buffer, hsize_t size) {
+  StatsTimer timer("read_into");
+  hid_t dataset_id = open_dataset(file_id, field);
+  if (!datatype_compatible(dataset_id, datatype_id)) {
+    H5Dclose(dataset_id);
+    auto msg = std::string("Lime error: wrong entry type in read_into: ") +
+               field;
+    throw std::runtime_error(msg);
+  }
+
+  // Select a single entry or the whole dataset
+  auto dims = get_dataspace_dims(dataset_id);
+  if ((idx >= 0) && (dims.empty() || ((hsize_t)idx >= dims[0]))) {
+    H5Dclose(dataset_id);
+    auto msg = std::string("Lime error: index out of range in read_into: ") +
+               field;
+    throw std::runtime_error(msg);
+  }
+  std::vector<hsize_t> offset(dims.size(), 0);
+  std::vector<hsize_t> count = dims;
+  if (idx >= 0) {
+    offset[0] = (hsize_t)idx;
+    count[0] = 1;
+  }
+
+  hsize_t field_size = 1;
+  for (auto c : count)
+    field_size *= c;
+  if (field_size != size) {
+    H5Dclose(dataset_id);
+    auto msg = std::string("Lime error: size of buffer in read_into does "
+                           "not agree with field: ") +
+               field;
+    throw std::runtime_error(msg);
+  }
+
+  if ((size > 0) && !dims.empty())
+    read_entries(dataset_id, datatype_id, offset[0], count[0], buffer);
+  else if (size > 0) {
+    hid_t filespace_id = H5Dget_space(dataset_id);
+    H5Sselect_hyperslab(filespace_id, H5S_SELECT_SET, offset.data(), NULL,
+                        count.data(), NULL);
+    hid_t memspace_id = H5Screate_simple(1, &size, NULL);
+    H5Dread(dataset_id, datatype_id, memspace_id, filespace_id, H5P_DEFAULT,
+            buffer);
+    H5Sclose(memspace_id);
+    H5Sclose(filespace_id);
+  }
+  H5Dclose(dataset_id);
+}
+
+} // namespace hdf5
+} // namespace lime
@@ -0,0 +1,50 @@
+#include "read_member.h"
+
+#include <stdexcept>
+
+#include <lime/hdf5/field_scope.h>
+
+namespace lime {
+namespace hdf5 {
+
+void read_member(hid_t file_id, std::string field, std::string member,
+                 hid_t datatype_id, EntriesAllocator const &allocate,
+                 EntryPointer const &entry) {
+  StatsTimer timer("read_member");
+  hid_t dataset_id = open_dataset(file_id, field);
+  hid_t field_datatype_id = H5Dget_type(dataset_id);
+  bool compatible = false;
+  if (H5Tget_class(field_datatype_id) == H5T_COMPOUND) {
+    int idx = H5Tget_member_index(field_datatype_id, member.c_str());
+    if (idx >= 0) {
+      hid_t member_id = H5Tget_member_type(field_datatype_id, (unsigned)idx);
+      compatible = H5Tequal(member_id, datatype_id) > 0;
+      H5Tclose(member_id);
+    }
+  }
+  H5Tclose(field_datatype_id);
+  if (!compatible) {
+    H5Dclose(dataset_id);
+    auto msg = std::string("Lime error: no member with given name and type "
+                           "in read_member: ") +
+               field + "/" + member;
+    throw std::runtime_error(msg);
+  }
+
+  hsize_t size = 1;
+  for (auto dim : get_dataspace_dims(dataset_id))
+    size *= dim;
+  allocate(size, {});
+
+  // Read through a compound type holding only the requested member
+  if (size > 0) {
+    hid_t memtype_id = H5Tcreate(H5T_COMPOUND, H5Tget_size(datatype_id));
+    H5Tinsert(memtype_id, member.c_str(), 0, datatype_id);
+    H5Dread(dataset_id, memtype_id, H5S_ALL, H5S_ALL, H5P_DEFAULT, entry(0));
+    H5Tclose(memtype_id);
+  }
+  H5Dclose(dataset_id);
+}
+
+} // namespace hdf5
+} // namespace lime
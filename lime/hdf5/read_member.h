@@ -0,0 +1,36 @@
+// Copyright 2020 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIME_HDF5_READ_MEMBER_H
+#define LIME_HDF5_READ_MEMBER_H
+
+#include <hdf5.h>
+#include <string>
+
+#include <lime/hdf5/utils.h>
+
+namespace lime {
+namespace hdf5 {
+
+// Function to read a single member of given datatype from all entries of a
+// compound field. The memory for the values is provided by allocate(size,
+// {}) and entry(0).
+void read_member(hid_t file_id, std::string field, std::string member,
+                 hid_t datatype_id, EntriesAllocator const &allocate,
+                 EntryPointer const &entry);
+
+} // namespace hdf5
+} // namespace lime
+
+#endif
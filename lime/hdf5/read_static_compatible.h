@@ -15,50 +15,26 @@
 #ifndef LIME_HDF5_READ_STATIC_COMPATIBLE_H
 #define LIME_HDF5_READ_STATIC_COMPATIBLE_H
 
-#include <complex>
 #include <hdf5.h>
 #include <string>
+#include <vector>
 
-#include <lila/all.h>
-#include <lime/hdf5/types.h>
+#include <lime/field_traits.h>
 
 namespace lime {
 namespace hdf5 {
 
-// Functions to check field with a scalar entry
-bool read_static_compatible(hid_t file_id, std::string field, lime_int data);
-bool read_static_compatible(hid_t file_id, std::string field, lime_uint data);
-bool read_static_compatible(hid_t file_id, std::string field, lime_long data);
-bool read_static_compatible(hid_t file_id, std::string field, lime_ulong data);
-bool read_static_compatible(hid_t file_id, std::string field, lime_llong data);
-bool read_static_compatible(hid_t file_id, std::string field, lime_ullong data);
-
-bool read_static_compatible(hid_t file_id, std::string field, lime_float data);
-bool read_static_compatible(hid_t file_id, std::string field, lime_double data);
-bool read_static_compatible(hid_t file_id, std::string field,
-                            lime_scomplex data);
+// Function to check a static field with an entry of given datatype/rank
 bool read_static_compatible(hid_t file_id, std::string field,
-                            lime_complex data);
+                            hid_t datatype_id, int rank);
 
-// Functions to check a field with a lila::Vector entry
-bool read_static_compatible(hid_t file_id, std::string field,
-                            lila::Vector<lime_float> data);
-bool read_static_compatible(hid_t file_id, std::string field,
-                            lila::Vector<lime_double> data);
-bool read_static_compatible(hid_t file_id, std::string field,
-                            lila::Vector<lime_scomplex> data);
-bool read_static_compatible(hid_t file_id, std::string field,
-                            lila::Vector<lime_complex> data);
+template <class data_t>
+inline bool read_static_compatible(hid_t file_id, std::string field,
+                                   data_t const &data) {
+  return read_static_compatible(file_id, field, field_datatype<data_t>(),
+                                field_traits<data_t>::rank);
+}
 
-// Functions to check a field with a lila::Matrix entry
-bool read_static_compatible(hid_t file_id, std::string field,
-                            lila::Matrix<lime_float> data);
-bool read_static_compatible(hid_t file_id, std::string field,
-                            lila::Matrix<lime_double> data);
-bool read_static_compatible(hid_t file_id, std::string field,
-                            lila::Matrix<lime_scomplex> data);
-bool read_static_compatible(hid_t file_id, std::string field,
-                            lila::Matrix<lime_complex> data);
 } // namespace hdf5
 } // namespace lime
 
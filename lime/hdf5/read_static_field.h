@@ -15,48 +15,32 @@
 #ifndef LIME_HDF5_READ_STATIC_FIELD_H
 #define LIME_HDF5_READ_STATIC_FIELD_H
 
-#include <complex>
 #include <hdf5.h>
 #include <string>
+#include <vector>
 
-#include <lila/all.h>
-#include <lime/hdf5/types.h>
+#include <lime/hdf5/utils.h>
+#include <lime/field_traits.h>
 
 namespace lime {
 namespace hdf5 {
 
-// Functions to read a field with a scalar entry
-void read_static_field(hid_t file_id, std::string field, lime_int &data);
-void read_static_field(hid_t file_id, std::string field, lime_uint &data);
-void read_static_field(hid_t file_id, std::string field, lime_long &data);
-void read_static_field(hid_t file_id, std::string field, lime_ulong &data);
-void read_static_field(hid_t file_id, std::string field, lime_llong &data);
-void read_static_field(hid_t file_id, std::string field, lime_ullong &data);
-
-void read_static_field(hid_t file_id, std::string field, lime_float &data);
-void read_static_field(hid_t file_id, std::string field, lime_double &data);
-void read_static_field(hid_t file_id, std::string field, lime_scomplex &data);
-void read_static_field(hid_t file_id, std::string field, lime_complex &data);
-
-// Functions to read a field with a lila::Vector entry
-void read_static_field(hid_t file_id, std::string field,
-                       lila::Vector<lime_float> &data);
-void read_static_field(hid_t file_id, std::string field,
-                       lila::Vector<lime_double> &data);
-void read_static_field(hid_t file_id, std::string field,
-                       lila::Vector<lime_scomplex> &data);
-void read_static_field(hid_t file_id, std::string field,
-                       lila::Vector<lime_complex> &data);
-
-// Functions to read a field with a lila::Matrix entry
-void read_static_field(hid_t file_id, std::string field,
-                       lila::Matrix<lime_float> &data);
-void read_static_field(hid_t file_id, std::string field,
-                       lila::Matrix<lime_double> &data);
-void read_static_field(hid_t file_id, std::string field,
-                       lila::Matrix<lime_scomplex> &data);
-void read_static_field(hid_t file_id, std::string field,
-                       lila::Matrix<lime_complex> &data);
+// Function to read the entry of a static field. The memory of the entry
+// is provided by allocate(shape) once its shape is known.
+void read_static_field(hid_t file_id, std::string field, hid_t datatype_id,
+                       bool colmajor, EntryAllocator const &allocate);
+
+template <class data_t>
+inline void read_static_field(hid_t file_id, std::string field,
+                              data_t &data) {
+  using traits = field_traits<data_t>;
+  read_static_field(file_id, field, field_datatype<data_t>(),
+                    traits::column_major,
+                    [&data](std::vector<hsize_t> const &shape) -> void * {
+                      traits::resize(data, shape);
+                      return traits::data(data);
+                    });
+}
 
 } // namespace hdf5
 } // namespace lime
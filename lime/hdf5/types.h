@@ -23,6 +23,11 @@
 
 #define LIME_FIELD_TYPE_STRING "LimeFieldType"
 #define LIME_FIELD_STATIC_EXTENSIBLE_STRING "LimeFieldStaticExtensible"
+#define LIME_FIELD_LAYOUT_STRING "LimeFieldLayout"
+#define LIME_FIELD_BIT_COUNT_STRING "LimeFieldBitCount"
+#define LIME_FIELD_STORAGE_TYPE_STRING "LimeFieldStorageType"
+#define LIME_FIELD_STATS_STRING "LimeFieldStats"
+#define LIME_FIELD_RECORD_TYPES_STRING "LimeFieldRecordTypes"
 
 namespace lime { namespace hdf5 {
 
@@ -32,6 +37,7 @@ using lime_long = long;
 using lime_ulong = unsigned long;
 using lime_llong = long long;
 using lime_ullong = unsigned long long;
+using lime_byte = unsigned char;
 
 using lime_float = float;
 using lime_double = double;
@@ -52,26 +58,40 @@ template <> inline hid_t hdf5_datatype<lime_llong>()
 { return H5T_NATIVE_LLONG; }
 template <> inline hid_t hdf5_datatype<lime_ullong>()
 { return H5T_NATIVE_ULLONG; }
+template <> inline hid_t hdf5_datatype<lime_byte>()
+{ return H5T_NATIVE_UCHAR; }
 template <> inline hid_t hdf5_datatype<lime_float>()
 { return H5T_NATIVE_FLOAT; }
 template <> inline hid_t hdf5_datatype<lime_double>()
 { return H5T_NATIVE_DOUBLE; }
+// Compound datatypes of complex numbers are created only once per process
+// and closed at shutdown. Callers must not close the returned ids.
+template <class float_t> class ComplexDatatype {
+public:
+  ComplexDatatype() {
+    id_ = H5Tcreate(H5T_COMPOUND, 2*sizeof(float_t));
+    H5Tinsert(id_, "r", 0*sizeof(float_t), hdf5_datatype<float_t>());
+    H5Tinsert(id_, "i", 1*sizeof(float_t), hdf5_datatype<float_t>());
+  }
+  ~ComplexDatatype() { if (H5Iis_valid(id_) > 0) H5Tclose(id_); }
+  ComplexDatatype(ComplexDatatype const&) = delete;
+  ComplexDatatype& operator=(ComplexDatatype const&) = delete;
+  inline hid_t id() const { return id_; }
+private:
+  hid_t id_;
+};
+
 template <> inline hid_t hdf5_datatype<lime_scomplex>()
 {
-  hid_t memtype = H5Tcreate(H5T_COMPOUND, 2*sizeof(float));
-  H5Tinsert(memtype, "r", 0*sizeof(float), H5T_NATIVE_FLOAT);
-  H5Tinsert(memtype, "i", 1*sizeof(float), H5T_NATIVE_FLOAT);
-  return memtype;
+  static const ComplexDatatype<lime_float> datatype;
+  return datatype.id();
 }
 template <> inline hid_t hdf5_datatype<lime_complex>()
 {
-  hid_t memtype = H5Tcreate(H5T_COMPOUND, 2*sizeof(double));
-  H5Tinsert(memtype, "r", 0*sizeof(double), H5T_NATIVE_DOUBLE);
-  H5Tinsert(memtype, "i", 1*sizeof(double), H5T_NATIVE_DOUBLE);
-  return memtype;
+  static const ComplexDatatype<lime_double> datatype;
+  return datatype.id();
 }
 
-
 }}
 
 #endif
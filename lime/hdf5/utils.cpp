@@ -1,5 +1,10 @@
 #include "utils.h"
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
 #include <lime/hdf5/types.h>
 
 namespace lime { namespace hdf5 {
@@ -24,22 +29,595 @@ std::vector<hsize_t> get_dataspace_max_dims(hid_t dataset_id)
   return max_dims;
 }
 
+// Shortest text of a double which reads back to the same value
+static std::string format_double(double value)
+{
+  std::string text;
+  for (int precision = 1; precision <= 17; ++precision)
+    {
+      std::ostringstream stream;
+      stream.precision(precision);
+      stream << value;
+      text = stream.str();
+      if (std::strtod(text.c_str(), NULL) == value)
+	break;
+    }
+  return text;
+}
+
+// Values of a numeric attribute as text, separated by spaces. Complex
+// numbers are written as (real,imag).
+static std::string format_attribute_values(hid_t attribute_id,
+					   hid_t dtype_id)
+{
+  hid_t space_id = H5Aget_space(attribute_id);
+  hssize_t npoints = H5Sget_simple_extent_npoints(space_id);
+  H5Sclose(space_id);
+  std::vector<std::string> values(npoints > 0 ? npoints : 0);
+  H5T_class_t dtype_class = H5Tget_class(dtype_id);
+  if ((dtype_class == H5T_INTEGER) && (H5Tget_sign(dtype_id) == H5T_SGN_NONE))
+    {
+      std::vector<unsigned long long> buffer(values.size());
+      H5Aread(attribute_id, H5T_NATIVE_ULLONG, buffer.data());
+      for (size_t idx = 0; idx < values.size(); ++idx)
+	values[idx] = std::to_string(buffer[idx]);
+    }
+  else if (dtype_class == H5T_INTEGER)
+    {
+      std::vector<long long> buffer(values.size());
+      H5Aread(attribute_id, H5T_NATIVE_LLONG, buffer.data());
+      for (size_t idx = 0; idx < values.size(); ++idx)
+	values[idx] = std::to_string(buffer[idx]);
+    }
+  else if (dtype_class == H5T_FLOAT)
+    {
+      std::vector<double> buffer(values.size());
+      H5Aread(attribute_id, H5T_NATIVE_DOUBLE, buffer.data());
+      for (size_t idx = 0; idx < values.size(); ++idx)
+	values[idx] = format_double(buffer[idx]);
+    }
+  else if ((dtype_class == H5T_COMPOUND) && (H5Tget_nmembers(dtype_id) == 2))
+    {
+      std::vector<lime_complex> buffer(values.size());
+      if (H5Aread(attribute_id, hdf5_datatype<lime_complex>(),
+		  buffer.data()) < 0)
+	return "";
+      for (size_t idx = 0; idx < values.size(); ++idx)
+	values[idx] = "(" + format_double(buffer[idx].real()) + "," +
+	  format_double(buffer[idx].imag()) + ")";
+    }
+  std::string text;
+  for (auto const &value : values)
+    text += (text.empty() ? "" : " ") + value;
+  return text;
+}
+
+// Value of an attribute as text, strings of fixed or variable length are
+// read as they are
+static std::string read_attribute_value(hid_t attribute_id)
+{
+  std::string attribute_value;
+  hid_t dtype_id = H5Aget_type(attribute_id);
+  if (H5Tget_class(dtype_id) != H5T_STRING)
+    attribute_value = format_attribute_values(attribute_id, dtype_id);
+  else if (H5Tis_variable_str(dtype_id) > 0)
+    {
+      // hdf5 allocates variable length strings, which it also frees
+      char* buffer = NULL;
+      H5Aread(attribute_id, dtype_id, &buffer);
+      if (buffer)
+	{
+	  attribute_value = buffer;
+	  H5free_memory(buffer);
+	}
+    }
+  else
+    {
+      std::vector<char> buffer(H5Aget_storage_size(attribute_id) + 1, '\0');
+      H5Aread(attribute_id, dtype_id, buffer.data());
+      attribute_value = buffer.data();
+    }
+  H5Tclose(dtype_id);
+  return attribute_value;
+}
+
 std::string get_attribute_value(hid_t dataset_id, std::string attribute_name)
 {
+  hid_t attribute_id = H5Aopen(dataset_id, attribute_name.c_str(),
+			       H5P_DEFAULT);
+  std::string attribute_value = read_attribute_value(attribute_id);
+  H5Aclose(attribute_id);
+  return attribute_value;
+}
+
+static herr_t read_attribute(hid_t location_id, const char *name,
+			     const H5A_info_t *info, void *values)
+{
+  hid_t attribute_id = H5Aopen(location_id, name, H5P_DEFAULT);
+  (*static_cast<std::map<std::string, std::string>*>(values))[name] =
+    read_attribute_value(attribute_id);
+  H5Aclose(attribute_id);
+  return 0;
+}
+
+// All attributes of a dataset, read in one pass
+std::map<std::string, std::string> get_attribute_values(hid_t dataset_id)
+{
+  std::map<std::string, std::string> values;
+  hsize_t idx = 0;
+  H5Aiterate2(dataset_id, H5_INDEX_NAME, H5_ITER_NATIVE, &idx,
+	      &read_attribute, &values);
+  return values;
+}
+
+static void write_attribute(hid_t dataset_id, hid_t str_type_id,
+			    hid_t string_space_id,
+			    std::string const &attribute_name,
+			    std::string const &attribute_value)
+{
+  // Existing attributes are replaced
+  if (H5Aexists(dataset_id, attribute_name.c_str()) > 0)
+    H5Adelete(dataset_id, attribute_name.c_str());
+  H5Tset_size(str_type_id, std::max((size_t)1, attribute_value.length()));
+  hid_t attribute_id =
+    H5Acreate(dataset_id, attribute_name.c_str(), str_type_id,
+	      string_space_id, H5P_DEFAULT, H5P_DEFAULT);
+  H5Awrite(attribute_id, str_type_id, attribute_value.c_str());
+  H5Aclose(attribute_id);
+}
+
+void set_attribute_value(hid_t dataset_id, std::string attribute_name,
+			 std::string attribute_value)
+{
+  set_attribute_values(dataset_id, {{attribute_name, attribute_value}});
+}
+
+// Several attributes of a dataset sharing their string type and dataspace
+void set_attribute_values(hid_t dataset_id,
+			  std::map<std::string, std::string> const &values)
+{
+  hid_t str_type_id = H5Tcopy(H5T_C_S1);
+  hid_t string_space_id = H5Screate(H5S_SCALAR);
+  for (auto const &value : values)
+    write_attribute(dataset_id, str_type_id, string_space_id, value.first,
+		    value.second);
+  H5Sclose(string_space_id);
+  H5Tclose(str_type_id);
+}
+
+// Attribute with numeric values of given datatype, a scalar if dims are
+// empty. Existing attributes are replaced.
+void set_attribute_data(hid_t dataset_id, std::string attribute_name,
+			hid_t datatype_id, std::vector<hsize_t> const &dims,
+			const void *data)
+{
+  if (H5Aexists(dataset_id, attribute_name.c_str()) > 0)
+    H5Adelete(dataset_id, attribute_name.c_str());
+  hid_t space_id;
+  if (dims.empty())
+    space_id = H5Screate(H5S_SCALAR);
+  else if (std::find(dims.begin(), dims.end(), 0) != dims.end())
+    space_id = H5Screate(H5S_NULL);
+  else
+    space_id = H5Screate_simple((int)dims.size(), dims.data(), NULL);
+  hid_t attribute_id = H5Acreate2(dataset_id, attribute_name.c_str(),
+				  datatype_id, space_id, H5P_DEFAULT,
+				  H5P_DEFAULT);
+  if (H5Sget_simple_extent_type(space_id) != H5S_NULL)
+    H5Awrite(attribute_id, datatype_id, data);
+  H5Aclose(attribute_id);
+  H5Sclose(space_id);
+}
+
+// Read the numeric values of an attribute converted to datatype into the
+// memory provided for its dims, false if the attribute doesn't exist, is
+// not numeric or the memory can't be provided
+bool get_attribute_data(hid_t dataset_id, std::string attribute_name,
+			hid_t datatype_id, EntryAllocator const &allocate)
+{
+  if (H5Aexists(dataset_id, attribute_name.c_str()) <= 0)
+    return false;
   hid_t attribute_id = H5Aopen(dataset_id, attribute_name.c_str(),
 			       H5P_DEFAULT);
   hid_t dtype_id = H5Aget_type(attribute_id);
-  hsize_t sz = H5Aget_storage_size(attribute_id);
-  char* attribute_value_c = new char[sz+1];
-  H5Aread(attribute_id, dtype_id, attribute_value_c);
-  attribute_value_c[sz] = '\0';
-  std::string attribute_value = std::string(attribute_value_c);
-  H5free_memory(attribute_value_c);
+  H5T_class_t dtype_class = H5Tget_class(dtype_id);
   H5Tclose(dtype_id);
+
+  // Numbers convert to numbers, complex numbers only to complex numbers
+  H5T_class_t datatype_class = H5Tget_class(datatype_id);
+  bool numeric = (dtype_class == H5T_INTEGER) || (dtype_class == H5T_FLOAT);
+  bool compatible = (datatype_class == H5T_COMPOUND)
+    ? (dtype_class == H5T_COMPOUND) : numeric;
+
+  hid_t space_id = H5Aget_space(attribute_id);
+  std::vector<hsize_t> dims = {0};
+  if (H5Sget_simple_extent_type(space_id) != H5S_NULL)
+    {
+      dims.resize(H5Sget_simple_extent_ndims(space_id));
+      H5Sget_simple_extent_dims(space_id, dims.data(), NULL);
+    }
+  H5Sclose(space_id);
+
+  void *data = compatible ? allocate(dims) : NULL;
+  bool read = compatible && (data != NULL);
+  if (read && (std::find(dims.begin(), dims.end(), 0) == dims.end()))
+    read = (H5Aread(attribute_id, datatype_id, data) >= 0);
   H5Aclose(attribute_id);
-  return attribute_value;
+  return read;
+}
+
+// Matrices written by older versions of lime are stored row-major without
+// a layout attribute, newer ones column-major with transposed dimensions
+bool column_major(hid_t dataset_id)
+{
+  return (H5Aexists(dataset_id, LIME_FIELD_LAYOUT_STRING) > 0) &&
+    (get_attribute_value(dataset_id, LIME_FIELD_LAYOUT_STRING) ==
+     "ColumnMajor");
+}
+
+// Number of values per entry of packed fields, -1 for other fields
+long bit_count(hid_t dataset_id)
+{
+  if (H5Aexists(dataset_id, LIME_FIELD_BIT_COUNT_STRING) > 0)
+    return std::stol(get_attribute_value(dataset_id,
+					 LIME_FIELD_BIT_COUNT_STRING));
+  else
+    return -1;
+}
+
+static hid_t float_datatype(FieldStorage::Precision precision)
+{
+  hid_t datatype_id = H5Tcopy(H5T_IEEE_F32LE);
+  if (precision == FieldStorage::Float16)
+    {
+      H5Tset_fields(datatype_id, 15, 10, 5, 0, 10);
+      H5Tset_size(datatype_id, 2);
+      H5Tset_ebias(datatype_id, 15);
+    }
+  return datatype_id;
+}
+
+// Datatype of coefficients stored with given precision, real and complex
+// floating point coefficients can be stored with reduced precision. Returns
+// a negative id if not possible, otherwise the datatype needs to be closed.
+hid_t storage_datatype(hid_t datatype_id, FieldStorage::Precision precision)
+{
+  H5T_class_t datatype_class = H5Tget_class(datatype_id);
+  if (precision == FieldStorage::Native)
+    return H5Tcopy(datatype_id);
+  else if (datatype_class == H5T_FLOAT)
+    return float_datatype(precision);
+  else if ((datatype_class == H5T_COMPOUND) &&
+	   (H5Tget_nmembers(datatype_id) == 2) &&
+	   (H5Tget_member_class(datatype_id, 0) == H5T_FLOAT) &&
+	   (H5Tget_member_class(datatype_id, 1) == H5T_FLOAT))
+    {
+      hid_t member_id = float_datatype(precision);
+      size_t size = H5Tget_size(member_id);
+      hid_t storage_id = H5Tcreate(H5T_COMPOUND, 2 * size);
+      H5Tinsert(storage_id, "r", 0, member_id);
+      H5Tinsert(storage_id, "i", size, member_id);
+      H5Tclose(member_id);
+      return storage_id;
+    }
+  else
+    return H5I_INVALID_HID;
+}
+
+// Coefficients of a field can be accessed with given memory datatype if
+// they are stored with this datatype or with its reduced storage precision
+bool datatype_compatible(hid_t dataset_id, hid_t datatype_id)
+{
+  hid_t field_datatype_id = H5Dget_type(dataset_id);
+  bool compatible = H5Tequal(field_datatype_id, datatype_id) > 0;
+  if (!compatible &&
+      (H5Aexists(dataset_id, LIME_FIELD_STORAGE_TYPE_STRING) > 0))
+    {
+      auto precision = precision_from_string
+	(get_attribute_value(dataset_id, LIME_FIELD_STORAGE_TYPE_STRING));
+      hid_t storage_id = storage_datatype(datatype_id, precision);
+      if (storage_id >= 0)
+	{
+	  compatible = H5Tequal(field_datatype_id, storage_id) > 0;
+	  H5Tclose(storage_id);
+	}
+    }
+  H5Tclose(field_datatype_id);
+  return compatible;
+}
+
+// Sets filters of a dataset creation property list for the given storage,
+// the dataset is chunked with chunk_dims if a filter is needed. Returns
+// false if the storage is not possible for the storage datatype.
+bool set_storage(hid_t plist_id, hid_t storage_id,
+		 std::vector<hsize_t> const &chunk_dims,
+		 FieldStorage const &storage)
+{
+  if (storage_id < 0)
+    return false;
+  else if (storage.scale_digits < 0)
+    return true;
+
+  // Scale-offset filter only supports real single/double precision
+  size_t size = H5Tget_size(storage_id);
+  if ((H5Tget_class(storage_id) != H5T_FLOAT) || ((size != 4) && (size != 8)))
+    return false;
+  if (H5Pget_layout(plist_id) != H5D_CHUNKED)
+    H5Pset_chunk(plist_id, (int)chunk_dims.size(), chunk_dims.data());
+  H5Pset_scaleoffset(plist_id, H5Z_SO_FLOAT_DSCALE, storage.scale_digits);
+  return true;
+}
+
+// Dimensions of an entry with given shape in a dataset, scalars are stored
+// as a single element and column-major entries with reversed dimensions
+std::vector<hsize_t> storage_dims(std::vector<hsize_t> const &shape,
+				  bool colmajor)
+{
+  if (shape.empty())
+    return {1};
+  else if (colmajor)
+    return std::vector<hsize_t>(shape.rbegin(), shape.rend());
+  else
+    return shape;
+}
+
+// Shape of an entry stored with the given dimensions in a dataset
+std::vector<hsize_t> entry_shape(std::vector<hsize_t> const &dims,
+				 bool colmajor)
+{
+  if (colmajor)
+    return std::vector<hsize_t>(dims.rbegin(), dims.rend());
+  else
+    return dims;
+}
+
+// Transpose a row-major nrows x ncols array of elements with nbytes each
+void transpose_entry(const char *source, char *target, hsize_t nrows,
+		     hsize_t ncols, size_t nbytes)
+{
+  for (hsize_t i = 0; i < nrows; ++i)
+    for (hsize_t j = 0; j < ncols; ++j)
+      std::memcpy(target + (j * nrows + i) * nbytes,
+		  source + (i * ncols + j) * nbytes, nbytes);
+}
+
+// Offset of raw data in file if it is stored contiguously without filters
+bool get_contiguous_offset(hid_t dataset_id, haddr_t &offset)
+{
+  hid_t plist_id = H5Dget_create_plist(dataset_id);
+  bool contiguous = (H5Pget_layout(plist_id) == H5D_CONTIGUOUS) &&
+    (H5Pget_nfilters(plist_id) == 0);
+  H5Pclose(plist_id);
+  offset = H5Dget_offset(dataset_id);
+  return contiguous && (offset != HADDR_UNDEF);
+}
+
+// Opens a (nested) group of a file, missing groups are created if create is
+// set, otherwise H5I_INVALID_HID is returned
+hid_t open_group(hid_t file_id, std::string group, bool create)
+{
+  std::string path;
+  size_t begin = 0;
+  while (begin <= group.size())
+    {
+      size_t end = std::min(group.find('/', begin), group.size());
+      if (end > begin)
+	{
+	  path += (path.empty() ? "" : "/") + group.substr(begin, end - begin);
+	  if (H5Lexists(file_id, path.c_str(), H5P_DEFAULT) <= 0)
+	    {
+	      if (!create)
+		return H5I_INVALID_HID;
+	      hid_t group_id = H5Gcreate2(file_id, path.c_str(), H5P_DEFAULT,
+					  H5P_DEFAULT, H5P_DEFAULT);
+	      H5Gclose(group_id);
+	    }
+	}
+      begin = end + 1;
+    }
+  return H5Gopen2(file_id, path.empty() ? "/" : path.c_str(), H5P_DEFAULT);
+}
+
+static size_t next_prime(size_t n)
+{
+  for (;; ++n)
+    {
+      bool prime = (n > 1);
+      for (size_t d = 2; prime && (d * d <= n); ++d)
+	prime = (n % d != 0);
+      if (prime)
+	return n;
+    }
+}
+
+// Dataset access property list with a chunk cache sized for the chunks of
+// a dataset, H5I_INVALID_HID if the dataset is not chunked
+hid_t chunk_cache_plist(hid_t dataset_id, ChunkCache const &cache,
+			bool append)
+{
+  hid_t plist_id = H5Dget_create_plist(dataset_id);
+  bool chunked = (H5Pget_layout(plist_id) == H5D_CHUNKED);
+  size_t chunk_bytes = 0;
+  if (chunked)
+    {
+      int rank = H5Pget_chunk(plist_id, 0, NULL);
+      std::vector<hsize_t> chunk_dims(rank > 0 ? rank : 0);
+      H5Pget_chunk(plist_id, rank, chunk_dims.data());
+      hid_t datatype_id = H5Dget_type(dataset_id);
+      chunk_bytes = H5Tget_size(datatype_id);
+      H5Tclose(datatype_id);
+      for (auto dim : chunk_dims)
+	chunk_bytes *= dim;
+    }
+  H5Pclose(plist_id);
+  if (!chunked || (chunk_bytes == 0))
+    return H5I_INVALID_HID;
+
+  // Appending only revisits the last chunk, random reads several chunks
+  if (cache.access != ChunkCache::Default)
+    append = (cache.access == ChunkCache::Append);
+  size_t nbytes = cache.nbytes;
+  if (nbytes == 0)
+    nbytes = std::max({std::min((append ? 2 : 16) * chunk_bytes,
+				(size_t)LIME_CHUNK_CACHE_MAX_BYTES),
+		       chunk_bytes, (size_t)LIME_CHUNK_CACHE_MIN_BYTES});
+  size_t nslots = cache.nslots;
+  if (nslots == 0)
+    nslots = next_prime(std::max((size_t)521, 100 * (nbytes / chunk_bytes)));
+  double w0 = (cache.w0 >= 0.) ? cache.w0 : (append ? 1. : 0.75);
+
+  hid_t access_id = H5Pcreate(H5P_DATASET_ACCESS);
+  H5Pset_chunk_cache(access_id, nslots, nbytes, w0);
+  return access_id;
+}
+
+static bool same_chunk_cache(hid_t dataset_id, hid_t access_id)
+{
+  hid_t plist_id = H5Dget_access_plist(dataset_id);
+  size_t nslots, nbytes, nslots2, nbytes2;
+  double w0, w02;
+  H5Pget_chunk_cache(plist_id, &nslots, &nbytes, &w0);
+  H5Pget_chunk_cache(access_id, &nslots2, &nbytes2, &w02);
+  H5Pclose(plist_id);
+  return (nslots == nslots2) && (nbytes == nbytes2) && (w0 == w02);
+}
+
+// Dataset of a field opened with a chunk cache sized for its chunks, whose
+// access property list is returned in access_id. H5I_INVALID_HID if the
+// dataset is not chunked. A cache which is set completely doesn't depend
+// on the chunks, the dataset is opened with it right away, otherwise it is
+// reopened if its cache differs.
+hid_t open_chunked_dataset(hid_t file_id, std::string field,
+			   ChunkCache const &cache, bool append,
+			   hid_t &access_id)
+{
+  access_id = H5I_INVALID_HID;
+  hid_t first_id = H5P_DEFAULT;
+  if ((cache.nbytes > 0) && (cache.nslots > 0) && (cache.w0 >= 0.))
+    {
+      first_id = H5Pcreate(H5P_DATASET_ACCESS);
+      H5Pset_chunk_cache(first_id, cache.nslots, cache.nbytes, cache.w0);
+    }
+  hid_t dataset_id = H5Dopen2(file_id, field.c_str(), first_id);
+  if (first_id != H5P_DEFAULT)
+    H5Pclose(first_id);
+  if (dataset_id < 0)
+    return H5I_INVALID_HID;
+
+  access_id = chunk_cache_plist(dataset_id, cache, append);
+  if (access_id < 0)
+    {
+      H5Dclose(dataset_id);
+      return H5I_INVALID_HID;
+    }
+  if (!same_chunk_cache(dataset_id, access_id))
+    {
+      H5Dclose(dataset_id);
+      dataset_id = H5Dopen2(file_id, field.c_str(), access_id);
+    }
+  return dataset_id;
+}
+
+// File creation property list of FileH5Options, H5I_INVALID_HID if the
+// options are not supported
+hid_t file_create_plist(FileH5Options const &options)
+{
+  hid_t plist_id = H5Pcreate(H5P_FILE_CREATE);
+  herr_t status = 0;
+  if (options.paged_aggregation)
+    {
+      status |= H5Pset_file_space_strategy(plist_id, H5F_FSPACE_STRATEGY_PAGE,
+					   0, (hsize_t)1);
+      // Unsupported page sizes are reported by FileH5
+      if (options.page_size > 0)
+	H5E_BEGIN_TRY {
+	  status |= H5Pset_file_space_page_size(plist_id, options.page_size);
+	} H5E_END_TRY;
+    }
+  if (status < 0)
+    {
+      H5Pclose(plist_id);
+      return H5I_INVALID_HID;
+    }
+  return plist_id;
+}
+
+// File access property list of FileH5Options, H5I_INVALID_HID if the
+// options are not supported
+hid_t file_access_plist(FileH5Options const &options)
+{
+  hid_t plist_id = H5Pcreate(H5P_FILE_ACCESS);
+  herr_t status = 0;
+  if (options.in_memory)
+    status |= H5Pset_fapl_core(plist_id, options.memory_increment,
+			       options.backing_store);
+  if (options.latest_format)
+    status |= H5Pset_libver_bounds(plist_id, H5F_LIBVER_LATEST,
+				   H5F_LIBVER_LATEST);
+  if (options.alignment > 1)
+    status |= H5Pset_alignment(plist_id, options.alignment_threshold,
+			       options.alignment);
+  if (options.page_buffer_bytes > 0)
+    status |= H5Pset_page_buffer_size(plist_id, options.page_buffer_bytes,
+				      0, 0);
+  if (options.meta_block_size > 0)
+    status |= H5Pset_meta_block_size(plist_id, options.meta_block_size);
+  if (options.metadata_cache_bytes > 0)
+    {
+      H5AC_cache_config_t config;
+      config.version = H5AC__CURR_CACHE_CONFIG_VERSION;
+      status |= H5Pget_mdc_config(plist_id, &config);
+      config.set_initial_size = true;
+      config.initial_size = options.metadata_cache_bytes;
+      config.min_size = std::min(config.min_size,
+				 options.metadata_cache_bytes);
+      config.max_size = std::max(config.max_size,
+				 options.metadata_cache_bytes);
+      status |= H5Pset_mdc_config(plist_id, &config);
+    }
+  if (status < 0)
+    {
+      H5Pclose(plist_id);
+      return H5I_INVALID_HID;
+    }
+  return plist_id;
+}
+
+static herr_t copy_attribute(hid_t source_id, const char *name,
+			     const H5A_info_t *info, void *target_id)
+{
+  hid_t attribute_id = H5Aopen(source_id, name, H5P_DEFAULT);
+  hid_t dtype_id = H5Aget_type(attribute_id);
+  hid_t space_id = H5Aget_space(attribute_id);
+  hssize_t npoints = H5Sget_simple_extent_npoints(space_id);
+  std::vector<char> buffer(H5Tget_size(dtype_id) * npoints);
+  H5Aread(attribute_id, dtype_id, buffer.data());
+
+  hid_t copy_id = H5Acreate2(*static_cast<hid_t*>(target_id), name, dtype_id,
+			     space_id, H5P_DEFAULT, H5P_DEFAULT);
+  H5Awrite(copy_id, dtype_id, buffer.data());
+  H5Aclose(copy_id);
+
+  // Free memory of variable length data
+  if (H5Tdetect_class(dtype_id, H5T_VLEN) || H5Tis_variable_str(dtype_id))
+    {
+#if H5_VERSION_GE(1, 12, 0)
+      H5Treclaim(dtype_id, space_id, H5P_DEFAULT, buffer.data());
+#else
+      H5Dvlen_reclaim(dtype_id, space_id, H5P_DEFAULT, buffer.data());
+#endif
+    }
+  H5Sclose(space_id);
+  H5Tclose(dtype_id);
+  H5Aclose(attribute_id);
+  return 0;
 }
 
+void copy_attributes(hid_t source_id, hid_t target_id)
+{
+  H5Aiterate2(source_id, H5_INDEX_NAME, H5_ITER_NATIVE, NULL,
+	      &copy_attribute, &target_id);
+}
 
 herr_t H5OvisitCompatible( hid_t object_id, H5_index_t index_type, H5_iter_order_t order, 
 			   H5O_iterate_t op, void *op_data )
@@ -17,14 +17,62 @@
 
 #include <vector>
 #include <complex>
+#include <functional>
+#include <map>
 #include <string>
 #include <hdf5.h>
 
+#include <lime/chunk_cache.h>
+#include <lime/field_storage.h>
+#include <lime/file_h5_options.h>
+
 namespace lime { namespace hdf5 {
 
+// Callbacks providing the memory of entries to be read from a field
+using EntryAllocator = std::function<void *(std::vector<hsize_t> const &shape)>;
+using EntriesAllocator =
+  std::function<void(hsize_t size, std::vector<hsize_t> const &shape)>;
+using EntryPointer = std::function<void *(hsize_t idx)>;
+
+// Callback providing the memory of entries to be written to a field
+using ConstEntryPointer = std::function<const void *(hsize_t idx)>;
+
 std::vector<hsize_t> get_dataspace_dims(hid_t dataset_id);
 std::vector<hsize_t> get_dataspace_max_dims(hid_t dataset_id);
 std::string get_attribute_value(hid_t dataset_id, std::string attribute_name);
+void set_attribute_value(hid_t dataset_id, std::string attribute_name,
+			 std::string attribute_value);
+std::map<std::string, std::string> get_attribute_values(hid_t dataset_id);
+void set_attribute_values(hid_t dataset_id,
+			  std::map<std::string, std::string> const &values);
+void set_attribute_data(hid_t dataset_id, std::string attribute_name,
+			hid_t datatype_id, std::vector<hsize_t> const &dims,
+			const void *data);
+bool get_attribute_data(hid_t dataset_id, std::string attribute_name,
+			hid_t datatype_id, EntryAllocator const &allocate);
+bool column_major(hid_t dataset_id);
+long bit_count(hid_t dataset_id);
+hid_t storage_datatype(hid_t datatype_id, FieldStorage::Precision precision);
+bool datatype_compatible(hid_t dataset_id, hid_t datatype_id);
+bool set_storage(hid_t plist_id, hid_t storage_id,
+		 std::vector<hsize_t> const &chunk_dims,
+		 FieldStorage const &storage);
+std::vector<hsize_t> storage_dims(std::vector<hsize_t> const &shape,
+				  bool colmajor);
+std::vector<hsize_t> entry_shape(std::vector<hsize_t> const &dims,
+				 bool colmajor);
+void transpose_entry(const char *source, char *target, hsize_t nrows,
+		     hsize_t ncols, size_t nbytes);
+bool get_contiguous_offset(hid_t dataset_id, haddr_t &offset);
+void copy_attributes(hid_t source_id, hid_t target_id);
+hid_t open_group(hid_t file_id, std::string group, bool create);
+hid_t chunk_cache_plist(hid_t dataset_id, ChunkCache const &cache,
+			bool append);
+hid_t open_chunked_dataset(hid_t file_id, std::string field,
+			   ChunkCache const &cache, bool append,
+			   hid_t &access_id);
+hid_t file_create_plist(FileH5Options const &options);
+hid_t file_access_plist(FileH5Options const &options);
 
 herr_t H5OvisitCompatible( hid_t object_id, H5_index_t index_type, H5_iter_order_t order, 
 			   H5O_iterate_t op, void *op_data );
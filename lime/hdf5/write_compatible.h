@@ -15,48 +15,26 @@
 #ifndef LIME_HDF5_WRITE_COMPATIBLE_H
 #define LIME_HDF5_WRITE_COMPATIBLE_H
 
-#include <complex>
 #include <hdf5.h>
 #include <string>
+#include <vector>
 
-#include <lila/all.h>
-#include <lime/hdf5/types.h>
+#include <lime/field_traits.h>
 
 namespace lime {
 namespace hdf5 {
 
-// Functions to check field with a scalar entry
-bool write_compatible(hid_t file_id, std::string field, lime_int data);
-bool write_compatible(hid_t file_id, std::string field, lime_uint data);
-bool write_compatible(hid_t file_id, std::string field, lime_long data);
-bool write_compatible(hid_t file_id, std::string field, lime_ulong data);
-bool write_compatible(hid_t file_id, std::string field, lime_llong data);
-bool write_compatible(hid_t file_id, std::string field, lime_ullong data);
-
-bool write_compatible(hid_t file_id, std::string field, lime_float data);
-bool write_compatible(hid_t file_id, std::string field, lime_double data);
-bool write_compatible(hid_t file_id, std::string field, lime_scomplex data);
-bool write_compatible(hid_t file_id, std::string field, lime_complex data);
-
-// Functions to check a field with a lila::Vector entry
-bool write_compatible(hid_t file_id, std::string field,
-                      lila::Vector<lime_float> data);
-bool write_compatible(hid_t file_id, std::string field,
-                      lila::Vector<lime_double> data);
-bool write_compatible(hid_t file_id, std::string field,
-                      lila::Vector<lime_scomplex> data);
-bool write_compatible(hid_t file_id, std::string field,
-                      lila::Vector<lime_complex> data);
-
-// Functions to check a field with a lila::Matrix entry
-bool write_compatible(hid_t file_id, std::string field,
-                      lila::Matrix<lime_float> data);
-bool write_compatible(hid_t file_id, std::string field,
-                      lila::Matrix<lime_double> data);
-bool write_compatible(hid_t file_id, std::string field,
-                      lila::Matrix<lime_scomplex> data);
-bool write_compatible(hid_t file_id, std::string field,
-                      lila::Matrix<lime_complex> data);
+// Function to check a static field with an entry of given datatype/shape
+bool write_compatible(hid_t file_id, std::string field, hid_t datatype_id,
+                      std::vector<hsize_t> const &shape, bool colmajor);
+
+template <class data_t>
+inline bool write_compatible(hid_t file_id, std::string field,
+                             data_t const &data) {
+  using traits = field_traits<data_t>;
+  return write_compatible(file_id, field, field_datatype<data_t>(),
+                          traits::shape(data), traits::column_major);
+}
 
 } // namespace hdf5
 } // namespace lime
@@ -0,0 +1,90 @@
+#include "write_entries.h"
+
+#include <stdexcept>
+#include <vector>
+
+#include <lime/hdf5/chunk_filters.h>
+#include <lime/hdf5/field_scope.h>
+#include <lime/hdf5/utils.h>
+
+namespace lime {
+namespace hdf5 {
+
+namespace {
+
+void write_hyperslab(hid_t dataset_id, hid_t datatype_id, hsize_t offset,
+                     hsize_t n_entries, const void *buffer) {
+  if (n_entries == 0)
+    return;
+  auto dims = get_dataspace_dims(dataset_id);
+  std::vector<hsize_t> start(dims.size(), 0);
+  start[0] = offset;
+  dims[0] = n_entries;
+  hid_t filespace_id = H5Dget_space(dataset_id);
+  H5Sselect_hyperslab(filespace_id, H5S_SELECT_SET, start.data(), NULL,
+                      dims.data(), NULL);
+  hid_t memspace_id = H5Screate_simple((int)dims.size(), dims.data(), NULL);
+  herr_t status = H5Dwrite(dataset_id, datatype_id, memspace_id,
+                           filespace_id, H5P_DEFAULT, buffer);
+  H5Sclose(memspace_id);
+  H5Sclose(filespace_id);
+  if (status < 0)
+    throw std::runtime_error("Lime error: can't write entries");
+}
+
+} // namespace
+
+void write_entries(hid_t dataset_id, hid_t datatype_id, hsize_t offset,
+                   hsize_t n_entries, const void *buffer) {
+  StatsTimer timer("write_entries");
+  auto dims = get_dataspace_dims(dataset_id);
+  size_t entry_bytes = H5Tget_size(datatype_id);
+  for (size_t d = 1; d < dims.size(); ++d)
+    entry_bytes *= (size_t)dims[d];
+
+  // Complete chunks are written directly if no type conversion is needed
+  hsize_t chunk_size = chunk_entries(dataset_id);
+  hsize_t first, last;
+  complete_chunks(offset, n_entries, chunk_size, first, last);
+  std::vector<ChunkFilter> filters;
+  if ((last == first) || (entry_bytes == 0) ||
+      !direct_chunks(dataset_id, datatype_id, filters)) {
+    write_hyperslab(dataset_id, datatype_id, offset, n_entries, buffer);
+    return;
+  }
+
+  const char *entries = (const char *)buffer;
+  write_hyperslab(dataset_id, datatype_id, offset, first - offset, entries);
+
+  // Chunks are filtered in parallel, hdf5 writes them one after another
+  size_t chunk_bytes = chunk_size * entry_bytes;
+  hsize_t n_chunks = (last - first) / chunk_size;
+  const char *chunks = entries + (first - offset) * entry_bytes;
+  std::vector<std::vector<char>> filtered(filters.empty() ? 0 : n_chunks);
+  if (!filters.empty() &&
+      !for_each_chunk(n_chunks, chunk_bytes, [&](hsize_t chunk) {
+        return filter_chunk(chunks + chunk * chunk_bytes, chunk_bytes,
+                            filters, filtered[chunk]);
+      }))
+    throw std::runtime_error("Lime error: can't compress chunk");
+
+  std::vector<hsize_t> chunk_offset(dims.size(), 0);
+  for (hsize_t chunk = 0; chunk < n_chunks; ++chunk) {
+    chunk_offset[0] = first + chunk * chunk_size;
+    herr_t status;
+    if (filters.empty())
+      status = H5Dwrite_chunk(dataset_id, H5P_DEFAULT, 0, chunk_offset.data(),
+                              chunk_bytes, chunks + chunk * chunk_bytes);
+    else
+      status = H5Dwrite_chunk(dataset_id, H5P_DEFAULT, 0, chunk_offset.data(),
+                              filtered[chunk].size(), filtered[chunk].data());
+    if (status < 0)
+      throw std::runtime_error("Lime error: can't write chunk");
+  }
+
+  write_hyperslab(dataset_id, datatype_id, last, offset + n_entries - last,
+                  entries + (last - offset) * entry_bytes);
+}
+
+} // namespace hdf5
+} // namespace lime
@@ -15,48 +15,26 @@
 #ifndef LIME_HDF5_WRITE_STATIC_FIELD_H
 #define LIME_HDF5_WRITE_STATIC_FIELD_H
 
-#include <complex>
 #include <hdf5.h>
 #include <string>
+#include <vector>
 
-#include <lila/all.h>
-#include <lime/hdf5/types.h>
+#include <lime/field_traits.h>
 
 namespace lime {
 namespace hdf5 {
 
-// Functions to write a field with a scalar entry
-void write_static_field(hid_t file_id, std::string field, lime_int data);
-void write_static_field(hid_t file_id, std::string field, lime_uint data);
-void write_static_field(hid_t file_id, std::string field, lime_long data);
-void write_static_field(hid_t file_id, std::string field, lime_ulong data);
-void write_static_field(hid_t file_id, std::string field, lime_llong data);
-void write_static_field(hid_t file_id, std::string field, lime_ullong data);
-
-void write_static_field(hid_t file_id, std::string field, lime_float data);
-void write_static_field(hid_t file_id, std::string field, lime_double data);
-void write_static_field(hid_t file_id, std::string field, lime_scomplex data);
-void write_static_field(hid_t file_id, std::string field, lime_complex data);
-
-// Functions to write a field with a lila::Vector entry
-void write_static_field(hid_t file_id, std::string field,
-                        lila::Vector<lime_float> const &data);
-void write_static_field(hid_t file_id, std::string field,
-                        lila::Vector<lime_double> const &data);
-void write_static_field(hid_t file_id, std::string field,
-                        lila::Vector<lime_scomplex> const &data);
-void write_static_field(hid_t file_id, std::string field,
-                        lila::Vector<lime_complex> const &data);
-
-// Functions to write a field with a lila::Matrix entry
-void write_static_field(hid_t file_id, std::string field,
-                        lila::Matrix<lime_float> const &data);
-void write_static_field(hid_t file_id, std::string field,
-                        lila::Matrix<lime_double> const &data);
-void write_static_field(hid_t file_id, std::string field,
-                        lila::Matrix<lime_scomplex> const &data);
-void write_static_field(hid_t file_id, std::string field,
-                        lila::Matrix<lime_complex> const &data);
+// Function to write an entry of given datatype to a static field
+void write_static_field(hid_t file_id, std::string field, hid_t datatype_id,
+                        const void *buffer, bool colmajor);
+
+template <class data_t>
+inline void write_static_field(hid_t file_id, std::string field,
+                               data_t const &data) {
+  using traits = field_traits<data_t>;
+  write_static_field(file_id, field, field_datatype<data_t>(),
+                     traits::data(data), traits::column_major);
+}
 
 } // namespace hdf5
 } // namespace lime
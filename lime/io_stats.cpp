@@ -0,0 +1,21 @@
+#include "io_stats.h"
+
+#include <sstream>
+
+namespace lime {
+
+std::string stats_string(FieldStats const &stats) {
+  std::ostringstream str;
+  str << "reads=" << stats.reads << " writes=" << stats.writes
+      << " appends=" << stats.appends
+      << " entries_appended=" << stats.entries_appended
+      << " bytes_read=" << stats.bytes_read
+      << " bytes_written=" << stats.bytes_written
+      << " extent_changes=" << stats.extent_changes
+      << " dataset_opens=" << stats.dataset_opens;
+  for (auto const &it : stats.seconds)
+    str << " seconds_" << it.first << "=" << it.second;
+  return str.str();
+}
+
+} // namespace lime
@@ -0,0 +1,42 @@
+// Copyright 2020 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIME_IO_STATS_H
+#define LIME_IO_STATS_H
+
+#include <map>
+#include <string>
+
+namespace lime {
+
+// I/O statistics of a single field, collected by FileH5 if enabled. Times
+// are given in seconds per hdf5 helper, including nested helpers.
+struct FieldStats {
+  long reads = 0;
+  long writes = 0;
+  long appends = 0;
+  long entries_appended = 0;
+  long bytes_read = 0;
+  long bytes_written = 0;
+  long extent_changes = 0;
+  long dataset_opens = 0;
+  std::map<std::string, double> seconds;
+};
+
+// Statistics as a string of "key=value" pairs separated by spaces
+std::string stats_string(FieldStats const &stats);
+
+} // namespace lime
+
+#endif
@@ -0,0 +1,62 @@
+#include "mapped_field.h"
+
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace lime {
+
+MappedRegion::MappedRegion(std::string filename, size_t offset, size_t nbytes)
+    : size_(nbytes) {
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    auto msg = std::string("Lime error: can't open file for mapping: ") +
+               filename;
+    throw std::runtime_error(msg);
+  }
+
+  // Mappings need to start at a page boundary
+  size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+  size_t page_offset = offset - offset % page_size;
+  map_size_ = nbytes + (offset - page_offset);
+  map_ = mmap(NULL, map_size_, PROT_READ, MAP_SHARED, fd, (off_t)page_offset);
+  close(fd);
+  if (map_ == MAP_FAILED) {
+    map_ = nullptr;
+    auto msg = std::string("Lime error: can't map file: ") + filename;
+    throw std::runtime_error(msg);
+  }
+  data_ = static_cast<const char *>(map_) + (offset - page_offset);
+}
+
+MappedRegion::MappedRegion(MappedRegion &&other) noexcept
+    : map_(other.map_), map_size_(other.map_size_), data_(other.data_),
+      size_(other.size_) {
+  other.map_ = nullptr;
+  other.data_ = nullptr;
+}
+
+MappedRegion &MappedRegion::operator=(MappedRegion &&other) noexcept {
+  if (this != &other) {
+    unmap();
+    map_ = other.map_;
+    map_size_ = other.map_size_;
+    data_ = other.data_;
+    size_ = other.size_;
+    other.map_ = nullptr;
+    other.data_ = nullptr;
+  }
+  return *this;
+}
+
+MappedRegion::~MappedRegion() { unmap(); }
+
+void MappedRegion::unmap() {
+  if (map_ != nullptr)
+    munmap(map_, map_size_);
+  map_ = nullptr;
+  data_ = nullptr;
+}
+
+} // namespace lime
@@ -0,0 +1,82 @@
+// Copyright 2020 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef LIME_MAPPED_FIELD_H
+#define LIME_MAPPED_FIELD_H
+
+#include <hdf5.h>
+#include <string>
+#include <vector>
+
+namespace lime {
+
+// Read-only memory mapping of a region of a file
+class MappedRegion {
+public:
+  MappedRegion() = default;
+  MappedRegion(std::string filename, size_t offset, size_t nbytes);
+  MappedRegion(MappedRegion const &) = delete;
+  MappedRegion &operator=(MappedRegion const &) = delete;
+  MappedRegion(MappedRegion &&other) noexcept;
+  MappedRegion &operator=(MappedRegion &&other) noexcept;
+  ~MappedRegion();
+
+  inline const char *data() const { return data_; }
+  inline size_t size() const { return size_; }
+
+private:
+  void *map_ = nullptr;
+  size_t map_size_ = 0;
+  const char *data_ = nullptr;
+  size_t size_ = 0;
+
+  void unmap();
+};
+
+// Read-only view of the entries of a field as returned by FileH5::map.
+// Contiguous, uncompressed datasets are memory mapped, otherwise the field
+// is read into a buffer. Entries are given in storage order of the dataset.
+template <class coeff_t> class MappedField {
+public:
+  MappedField() = default;
+  MappedField(MappedField const &) = delete;
+  MappedField &operator=(MappedField const &) = delete;
+  MappedField(MappedField &&) = default;
+  MappedField &operator=(MappedField &&) = default;
+  ~MappedField() = default;
+
+  inline bool mapped() const { return region_.data() != nullptr; }
+  inline std::vector<hsize_t> shape() const { return shape_; }
+  inline size_t size() const { return size_; }
+
+  inline const coeff_t *data() const {
+    return mapped() ? reinterpret_cast<const coeff_t *>(region_.data())
+                    : buffer_.data();
+  }
+  inline const coeff_t *begin() const { return data(); }
+  inline const coeff_t *end() const { return data() + size_; }
+  inline coeff_t const &operator[](size_t idx) const { return data()[idx]; }
+
+private:
+  friend class FileH5;
+  MappedRegion region_;
+  std::vector<coeff_t> buffer_;
+  std::vector<hsize_t> shape_;
+  size_t size_ = 0;
+};
+
+} // namespace lime
+
+#endif
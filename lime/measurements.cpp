@@ -2,7 +2,8 @@
 
 #include <algorithm>
 
-#include <lime/type_string.h>
+#include <lime/append_log.h>
+#include <lime/field_traits.h>
 
 namespace lime {
 
@@ -20,92 +21,24 @@ long Measurements::previous_dump(std::string field) const {
   return previous_dump_.at(field);
 }
 
-long Measurements::size(std::string field) const {
-  long size = 0;
-  if (type(field) == "IntScalar")
-    size = (long)collector_i_sca_.at(field).size();
-  else if (type(field) == "UintScalar")
-    size = (long)collector_u_sca_.at(field).size();
-  else if (type(field) == "LongScalar")
-    size = (long)collector_l_sca_.at(field).size();
-  else if (type(field) == "UlongScalar")
-    size = (long)collector_ul_sca_.at(field).size();
-  else if (type(field) == "LlongScalar")
-    size = (long)collector_ll_sca_.at(field).size();
-  else if (type(field) == "UllongScalar")
-    size = (long)collector_ull_sca_.at(field).size();
-
-  else if (type(field) == "FloatScalar")
-    size = (long)collector_s_sca_.at(field).size();
-  else if (type(field) == "DoubleScalar")
-    size = (long)collector_d_sca_.at(field).size();
-  else if (type(field) == "ComplexFloatScalar")
-    size = (long)collector_c_sca_.at(field).size();
-  else if (type(field) == "ComplexDoubleScalar")
-    size = (long)collector_z_sca_.at(field).size();
-
-  else if (type(field) == "FloatVector")
-    size = (long)collector_s_vec_.at(field).size();
-  else if (type(field) == "DoubleVector")
-    size = (long)collector_d_vec_.at(field).size();
-  else if (type(field) == "ComplexFloatVector")
-    size = (long)collector_c_vec_.at(field).size();
-  else if (type(field) == "ComplexDoubleVector")
-    size = (long)collector_z_vec_.at(field).size();
-
-  else if (type(field) == "FloatMatrix")
-    size = (long)collector_s_mat_.at(field).size();
-  else if (type(field) == "DoubleMatrix")
-    size = (long)collector_d_mat_.at(field).size();
-  else if (type(field) == "ComplexFloatMatrix")
-    size = (long)collector_c_mat_.at(field).size();
-  else if (type(field) == "ComplexDoubleMatrix")
-    size = (long)collector_z_mat_.at(field).size();
-  else {
-    auto msg = std::string("Lime error: Invalid field type in dump");
-    throw std::runtime_error(msg);
-  }
-  return size;
-}
-
 template <class data_t>
-void Measurements::append(std::string field, data_t const &data) {
-  std::string type = type_string(data);
-
-  // Create new field if not already present
-  if (!defined(field)) {
-    fields_.push_back(field);
-    type_[field] = type;
-    previous_dump_[field] = (long)0;
-  }
-  // Check if type agrees with previously defined type
-  else {
-    if (type != type_[field]) {
-      auto msg = std::string("Lime error: field already defined with "
-                             "different type.");
-      throw std::runtime_error(msg);
-    }
-  }
-  collector(data)[field].push_back(data);
+long collector_size(std::string field,
+                    std::map<std::string, std::vector<data_t>> const &collector) {
+  auto it = collector.find(field);
+  return (it == collector.end()) ? 0 : (long)it->second.size();
 }
 
-template <class data_t>
-void Measurements::get(std::string field, long idx, data_t &data) const {
-  if (defined(field)) {
-    if (type(field) == type_string(data))
-      data = collector(data).at(field).at(idx);
-    else {
-
-      std::cout << type(field) <<" --- " << type_string(data) << "\n"; 
-      auto msg = std::string("Lime error: cannot get field in "
-                             "measurements. Incompatible types.");
-      throw std::runtime_error(msg);
-    }
-  } else {
-    auto msg = std::string("Lime error: cannot find field in \"get\""
-                           " for measurements.");
+long Measurements::size(std::string field) const {
+  long size = 0;
+  bool valid = dispatch_field_type(type(field), [&](auto tag) {
+    using data_t = typename decltype(tag)::type;
+    size = collector_size(field, this->template collector<data_t>());
+  });
+  if (!valid) {
+    auto msg = std::string("Lime error: Invalid field type in size");
     throw std::runtime_error(msg);
   }
+  return offset_.at(field) + size;
 }
 
 template <class data_t>
@@ -126,109 +59,103 @@ void Measurements::read(FileH5 const &file) {
       type_[field] = file.type(field);
 
       long prev_dump = 0;
-      if (type(field) == "IntScalar")
-        prev_dump = read_collector(file, field, collector_i_sca_);
-      else if (type(field) == "UintScalar")
-        prev_dump = read_collector(file, field, collector_u_sca_);
-      else if (type(field) == "LongScalar")
-        prev_dump = read_collector(file, field, collector_l_sca_);
-      else if (type(field) == "UlongScalar")
-        prev_dump = read_collector(file, field, collector_ul_sca_);
-      else if (type(field) == "LlongScalar")
-        prev_dump = read_collector(file, field, collector_ll_sca_);
-      else if (type(field) == "UllongScalar")
-        prev_dump = read_collector(file, field, collector_ull_sca_);
-
-      else if (type(field) == "FloatScalar")
-        prev_dump = read_collector(file, field, collector_s_sca_);
-      else if (type(field) == "DoubleScalar")
-        prev_dump = read_collector(file, field, collector_d_sca_);
-      else if (type(field) == "ComplexFloatScalar")
-        prev_dump = read_collector(file, field, collector_c_sca_);
-      else if (type(field) == "ComplexDoubleScalar")
-        prev_dump = read_collector(file, field, collector_z_sca_);
-
-      else if (type(field) == "FloatVector")
-        prev_dump = read_collector(file, field, collector_s_vec_);
-      else if (type(field) == "DoubleVector")
-        prev_dump = read_collector(file, field, collector_d_vec_);
-      else if (type(field) == "ComplexFloatVector")
-        prev_dump = read_collector(file, field, collector_c_vec_);
-      else if (type(field) == "ComplexDoubleVector")
-        prev_dump = read_collector(file, field, collector_z_vec_);
-
-      else if (type(field) == "FloatMatrix")
-        prev_dump = read_collector(file, field, collector_s_mat_);
-      else if (type(field) == "DoubleMatrix")
-        prev_dump = read_collector(file, field, collector_d_mat_);
-      else if (type(field) == "ComplexFloatMatrix")
-        prev_dump = read_collector(file, field, collector_c_mat_);
-      else if (type(field) == "ComplexDoubleMatrix")
-        prev_dump = read_collector(file, field, collector_z_mat_);
-      else {
+      bool valid = dispatch_field_type(type(field), [&](auto tag) {
+        using data_t = typename decltype(tag)::type;
+        prev_dump =
+            read_collector(file, field, this->template collector<data_t>());
+      });
+      if (!valid) {
         auto msg = std::string("Lime error: Invalid field type in "
                                "read");
         throw std::runtime_error(msg);
       }
       previous_dump_[field] = prev_dump;
+      previous_log_[field] = prev_dump;
+      offset_[field] = (long)0;
     }
   }
+
+  // Recover measurements which have only been written to the log
+  if (!checkpoint_log_.empty())
+    replay_log();
+}
+
+void Measurements::resume(FileH5 const &file) {
+  for (std::string field : file.fields()) {
+    // Only consider extensible fields, only their extent is read
+    if (file.extensible(field)) {
+      fields_.push_back(field);
+      type_[field] = file.type(field);
+      long length = file.size(field);
+      previous_dump_[field] = length;
+      previous_log_[field] = length;
+      offset_[field] = length;
+    }
+  }
+  resume_filename_ = file.filename();
+  resume_group_ = file.group();
+  resume_options_ = file.options();
+  resume_file_.reset();
+
+  // Recover measurements which have only been written to the log
+  if (!checkpoint_log_.empty())
+    replay_log();
+}
+
+FileH5 const &Measurements::resume_file() const {
+  if (resume_filename_.empty()) {
+    auto msg = std::string("Lime error: entry of resumed field not "
+                           "available, no file given.");
+    throw std::runtime_error(msg);
+  }
+  // The reader is closed with the last Measurements sharing it, FileH5
+  // doesn't close itself
+  if (!resume_file_)
+    resume_file_ = std::shared_ptr<FileH5>(
+        new FileH5(resume_filename_, "r", resume_options_, resume_group_),
+        [](FileH5 *file) {
+          file->close();
+          delete file;
+        });
+  return *resume_file_;
 }
 
 template <class data_t>
 long dump_collector(
-    FileH5 &file, std::string field, long start,
+    FileH5 &file, std::string field, long start, long offset,
     std::map<std::string, std::vector<data_t>> const &collector) {
-  long end = (long)collector.at(field).size();
-  for (long idx = start; idx < end; ++idx)
-    file.append(field, collector.at(field).at(idx));
+  auto it = collector.find(field);
+  if (it == collector.end())
+    return offset;
+  long end = offset + (long)it->second.size();
+
+  // New entries are appended with a single write
+  if (end > start)
+    file.append(field, it->second.data() + (start - offset), end - start);
   return end;
 }
 
 void Measurements::dump(FileH5 &file) {
+  if (checkpoint_log_.empty())
+    dump_file(file);
+  else {
+    dump_log();
+    if (++dumps_since_fold_ >= fold_interval_)
+      fold(file);
+  }
+}
+
+void Measurements::dump_file(FileH5 &file) {
   for (auto field : fields_) {
     long start = previous_dump(field);
+    long offset = offset_.at(field);
     long end = 0;
-    if (type(field) == "IntScalar")
-      end = dump_collector(file, field, start, collector_i_sca_);
-    else if (type(field) == "UintScalar")
-      end = dump_collector(file, field, start, collector_u_sca_);
-    else if (type(field) == "LongScalar")
-      end = dump_collector(file, field, start, collector_l_sca_);
-    else if (type(field) == "UlongScalar")
-      end = dump_collector(file, field, start, collector_ul_sca_);
-    else if (type(field) == "LlongScalar")
-      end = dump_collector(file, field, start, collector_ll_sca_);
-    else if (type(field) == "UllongScalar")
-      end = dump_collector(file, field, start, collector_ull_sca_);
-
-    else if (type(field) == "FloatScalar")
-      end = dump_collector(file, field, start, collector_s_sca_);
-    else if (type(field) == "DoubleScalar")
-      end = dump_collector(file, field, start, collector_d_sca_);
-    else if (type(field) == "ComplexFloatScalar")
-      end = dump_collector(file, field, start, collector_c_sca_);
-    else if (type(field) == "ComplexDoubleScalar")
-      end = dump_collector(file, field, start, collector_z_sca_);
-
-    else if (type(field) == "FloatVector")
-      end = dump_collector(file, field, start, collector_s_vec_);
-    else if (type(field) == "DoubleVector")
-      end = dump_collector(file, field, start, collector_d_vec_);
-    else if (type(field) == "ComplexFloatVector")
-      end = dump_collector(file, field, start, collector_c_vec_);
-    else if (type(field) == "ComplexDoubleVector")
-      end = dump_collector(file, field, start, collector_z_vec_);
-
-    else if (type(field) == "FloatMatrix")
-      end = dump_collector(file, field, start, collector_s_mat_);
-    else if (type(field) == "DoubleMatrix")
-      end = dump_collector(file, field, start, collector_d_mat_);
-    else if (type(field) == "ComplexFloatMatrix")
-      end = dump_collector(file, field, start, collector_c_mat_);
-    else if (type(field) == "ComplexDoubleMatrix")
-      end = dump_collector(file, field, start, collector_z_mat_);
-    else {
+    bool valid = dispatch_field_type(type(field), [&](auto tag) {
+      using data_t = typename decltype(tag)::type;
+      end = dump_collector(file, field, start, offset,
+                           this->template collector<data_t>());
+    });
+    if (!valid) {
       auto msg = std::string("Lime error: Invalid field type in dump");
       throw std::runtime_error(msg);
     }
@@ -236,238 +163,112 @@ void Measurements::dump(FileH5 &file) {
   }
 }
 
-// Collector as reference
-template <>
-inline std::map<std::string, std::vector<int>> &
-Measurements::collector(int const &data) {
-  return collector_i_sca_;
-}
-template <>
-inline std::map<std::string, std::vector<unsigned>> &
-Measurements::collector(unsigned const &data) {
-  return collector_u_sca_;
-}
-template <>
-inline std::map<std::string, std::vector<long>> &
-Measurements::collector(long const &data) {
-  return collector_l_sca_;
-}
-template <>
-inline std::map<std::string, std::vector<unsigned long>> &
-Measurements::collector(unsigned long const &data) {
-  return collector_ul_sca_;
-}
-template <>
-inline std::map<std::string, std::vector<long long>> &
-Measurements::collector(long long const &data) {
-  return collector_ll_sca_;
-}
-template <>
-inline std::map<std::string, std::vector<unsigned long long>> &
-Measurements::collector(unsigned long long const &data) {
-  return collector_ull_sca_;
+void Measurements::checkpoint(std::string logfile, long fold_interval) {
+  if (fold_interval < 1) {
+    auto msg = std::string("Lime error: fold interval of checkpoint "
+                           "must be positive");
+    throw std::runtime_error(msg);
+  }
+  checkpoint_log_ = logfile;
+  fold_interval_ = fold_interval;
+  dumps_since_fold_ = 0;
 }
 
-template <>
-inline std::map<std::string, std::vector<sscalar>> &
-Measurements::collector(sscalar const &data) {
-  return collector_s_sca_;
-}
-template <>
-inline std::map<std::string, std::vector<dscalar>> &
-Measurements::collector(dscalar const &data) {
-  return collector_d_sca_;
-}
-template <>
-inline std::map<std::string, std::vector<cscalar>> &
-Measurements::collector(cscalar const &data) {
-  return collector_c_sca_;
-}
-template <>
-inline std::map<std::string, std::vector<zscalar>> &
-Measurements::collector(zscalar const &data) {
-  return collector_z_sca_;
-}
+void Measurements::fold(FileH5 &file) {
+  dump_file(file);
+  file.flush();
 
-template <>
-inline std::map<std::string, std::vector<svector>> &
-Measurements::collector(svector const &data) {
-  return collector_s_vec_;
-}
-template <>
-inline std::map<std::string, std::vector<dvector>> &
-Measurements::collector(dvector const &data) {
-  return collector_d_vec_;
-}
-template <>
-inline std::map<std::string, std::vector<cvector>> &
-Measurements::collector(cvector const &data) {
-  return collector_c_vec_;
-}
-template <>
-inline std::map<std::string, std::vector<zvector>> &
-Measurements::collector(zvector const &data) {
-  return collector_z_vec_;
+  // Everything is in the file now, the log can be discarded
+  if (!checkpoint_log_.empty()) {
+    AppendLog(checkpoint_log_).clear();
+    for (auto field : fields_)
+      previous_log_[field] = previous_dump_[field];
+  }
+  dumps_since_fold_ = 0;
 }
 
-template <>
-inline std::map<std::string, std::vector<smatrix>> &
-Measurements::collector(smatrix const &data) {
-  return collector_s_mat_;
-}
-template <>
-inline std::map<std::string, std::vector<dmatrix>> &
-Measurements::collector(dmatrix const &data) {
-  return collector_d_mat_;
-}
-template <>
-inline std::map<std::string, std::vector<cmatrix>> &
-Measurements::collector(cmatrix const &data) {
-  return collector_c_mat_;
-}
-template <>
-inline std::map<std::string, std::vector<zmatrix>> &
-Measurements::collector(zmatrix const &data) {
-  return collector_z_mat_;
+template <class data_t>
+long log_collector(AppendLog &log, std::string field, long start, long offset,
+                   std::map<std::string, std::vector<data_t>> const &collector) {
+  auto it = collector.find(field);
+  if (it == collector.end())
+    return offset;
+  long end = offset + (long)it->second.size();
+  for (long idx = start; idx < end; ++idx)
+    log.write(field, idx, it->second.at(idx - offset));
+  return end;
 }
 
-// Collector as const-reference
-template <>
-inline std::map<std::string, std::vector<int>> const &
-Measurements::collector(int const &data) const {
-  return collector_i_sca_;
-}
-template <>
-inline std::map<std::string, std::vector<unsigned>> const &
-Measurements::collector(unsigned const &data) const {
-  return collector_u_sca_;
-}
-template <>
-inline std::map<std::string, std::vector<long>> const &
-Measurements::collector(long const &data) const {
-  return collector_l_sca_;
-}
-template <>
-inline std::map<std::string, std::vector<unsigned long>> const &
-Measurements::collector(unsigned long const &data) const {
-  return collector_ul_sca_;
-}
-template <>
-inline std::map<std::string, std::vector<long long>> const &
-Measurements::collector(long long const &data) const {
-  return collector_ll_sca_;
-}
-template <>
-inline std::map<std::string, std::vector<unsigned long long>> const &
-Measurements::collector(unsigned long long const &data) const {
-  return collector_ull_sca_;
-}
+void Measurements::dump_log() {
+  AppendLog log(checkpoint_log_);
+  std::map<std::string, long> logged;
+  for (auto field : fields_) {
+    long start = previous_log_.at(field);
+    long offset = offset_.at(field);
+    long end = 0;
+    bool valid = dispatch_field_type(type(field), [&](auto tag) {
+      using data_t = typename decltype(tag)::type;
+      end = log_collector(log, field, start, offset,
+                          this->template collector<data_t>());
+    });
+    if (!valid) {
+      auto msg = std::string("Lime error: Invalid field type in log");
+      throw std::runtime_error(msg);
+    }
+    logged[field] = end;
+  }
 
-template <>
-inline std::map<std::string, std::vector<sscalar>> const &
-Measurements::collector(sscalar const &data) const {
-  return collector_s_sca_;
-}
-template <>
-inline std::map<std::string, std::vector<dscalar>> const &
-Measurements::collector(dscalar const &data) const {
-  return collector_d_sca_;
-}
-template <>
-inline std::map<std::string, std::vector<cscalar>> const &
-Measurements::collector(cscalar const &data) const {
-  return collector_c_sca_;
-}
-template <>
-inline std::map<std::string, std::vector<zscalar>> const &
-Measurements::collector(zscalar const &data) const {
-  return collector_z_sca_;
+  // Only consider measurements as logged once they are on disk
+  log.sync();
+  for (auto const &it : logged)
+    previous_log_[it.first] = it.second;
 }
 
-template <>
-inline std::map<std::string, std::vector<svector>> const &
-Measurements::collector(svector const &data) const {
-  return collector_s_vec_;
-}
-template <>
-inline std::map<std::string, std::vector<dvector>> const &
-Measurements::collector(dvector const &data) const {
-  return collector_d_vec_;
-}
-template <>
-inline std::map<std::string, std::vector<cvector>> const &
-Measurements::collector(cvector const &data) const {
-  return collector_c_vec_;
-}
-template <>
-inline std::map<std::string, std::vector<zvector>> const &
-Measurements::collector(zvector const &data) const {
-  return collector_z_vec_;
-}
+template <class data_t>
+void replay_record(AppendLogRecord const &record,
+                   std::map<std::string, std::vector<data_t>> &collector) {
+  data_t data;
+  read_record(record, data);
+  collector[record.field].push_back(data);
+}
+
+void Measurements::replay_log() {
+  AppendLog log(checkpoint_log_);
+  for (auto const &record : log.repair()) {
+    std::string field = record.field;
+    if (!defined(field)) {
+      fields_.push_back(field);
+      type_[field] = record.type;
+      previous_dump_[field] = (long)0;
+      offset_[field] = (long)0;
+    } else if (type(field) != record.type) {
+      auto msg = std::string("Lime error: field in checkpoint log "
+                             "defined with different type.");
+      throw std::runtime_error(msg);
+    }
+    long current = size(field);
+
+    // Skip records which have already been folded into the file
+    if (record.index < current)
+      continue;
+    else if (record.index > current) {
+      auto msg = std::string("Lime error: missing records in "
+                             "checkpoint log for field: ") +
+                 field;
+      throw std::runtime_error(msg);
+    }
 
-template <>
-inline std::map<std::string, std::vector<smatrix>> const &
-Measurements::collector(smatrix const &data) const {
-  return collector_s_mat_;
-}
-template <>
-inline std::map<std::string, std::vector<dmatrix>> const &
-Measurements::collector(dmatrix const &data) const {
-  return collector_d_mat_;
-}
-template <>
-inline std::map<std::string, std::vector<cmatrix>> const &
-Measurements::collector(cmatrix const &data) const {
-  return collector_c_mat_;
-}
-template <>
-inline std::map<std::string, std::vector<zmatrix>> const &
-Measurements::collector(zmatrix const &data) const {
-  return collector_z_mat_;
+    bool valid = dispatch_field_type(type(field), [&](auto tag) {
+      using data_t = typename decltype(tag)::type;
+      replay_record(record, this->template collector<data_t>());
+    });
+    if (!valid) {
+      auto msg = std::string("Lime error: Invalid field type in checkpoint log");
+      throw std::runtime_error(msg);
+    }
+  }
+  for (auto field : fields_)
+    previous_log_[field] = size(field);
 }
 
-template void Measurements::append(std::string, int const &);
-template void Measurements::append(std::string, unsigned const &);
-template void Measurements::append(std::string, long const &);
-template void Measurements::append(std::string, unsigned long const &);
-template void Measurements::append(std::string, long long const &);
-template void Measurements::append(std::string, unsigned long long const &);
-
-template void Measurements::append(std::string, sscalar const &);
-template void Measurements::append(std::string, dscalar const &);
-template void Measurements::append(std::string, cscalar const &);
-template void Measurements::append(std::string, zscalar const &);
-
-template void Measurements::append(std::string, svector const &);
-template void Measurements::append(std::string, dvector const &);
-template void Measurements::append(std::string, cvector const &);
-template void Measurements::append(std::string, zvector const &);
-
-template void Measurements::append(std::string, smatrix const &);
-template void Measurements::append(std::string, dmatrix const &);
-template void Measurements::append(std::string, cmatrix const &);
-template void Measurements::append(std::string, zmatrix const &);
-
-template void Measurements::get(std::string, long, int &) const;
-template void Measurements::get(std::string, long, unsigned &) const;
-template void Measurements::get(std::string, long, long &) const;
-template void Measurements::get(std::string, long, unsigned long &) const;
-template void Measurements::get(std::string, long, long long &) const;
-template void Measurements::get(std::string, long, unsigned long long &) const;
-
-template void Measurements::get(std::string, long, sscalar &) const;
-template void Measurements::get(std::string, long, dscalar &) const;
-template void Measurements::get(std::string, long, cscalar &) const;
-template void Measurements::get(std::string, long, zscalar &) const;
-
-template void Measurements::get(std::string, long, svector &) const;
-template void Measurements::get(std::string, long, dvector &) const;
-template void Measurements::get(std::string, long, cvector &) const;
-template void Measurements::get(std::string, long, zvector &) const;
-
-template void Measurements::get(std::string, long, smatrix &) const;
-template void Measurements::get(std::string, long, dmatrix &) const;
-template void Measurements::get(std::string, long, cmatrix &) const;
-template void Measurements::get(std::string, long, zmatrix &) const;
-
 } // namespace lime
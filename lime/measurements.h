@@ -17,14 +17,30 @@
 
 #include <hdf5.h>
 #include <map>
+#include <memory>
+#include <stdexcept>
 #include <string>
+#include <tuple>
+#include <type_traits>
 #include <vector>
 
+#include <lime/field_traits.h>
 #include <lime/file_h5.h>
 #include <lime/measurement_handler.h>
+#include <lime/type_string.h>
 #include <lime/types.h>
 
 namespace lime {
+
+template <class data_t>
+using collector_t = std::map<std::string, std::vector<data_t>>;
+
+// Tuple of collectors for every field type
+template <class types> struct collectors_of;
+template <class... data_t> struct collectors_of<std::tuple<data_t...>> {
+  using type = std::tuple<collector_t<data_t>...>;
+};
+
 class Measurements {
 
 public:
@@ -47,9 +63,20 @@ public:
   template <class data_t>
   void get(std::string field, long idx, data_t &data) const;
 
+  // Fields of a file opened on a group are read from and dumped to the
+  // group, hierarchical field names are dumped into nested groups
   void read(FileH5 const &file);
   void dump(FileH5 &file);
 
+  // Continue measurements of a file without reading previous entries,
+  // get(...) reads these entries from the file reopened read-only
+  void resume(FileH5 const &file);
+
+  // Checkpoint mode: dump(...) appends to a write-ahead log which is folded
+  // into the file every fold_interval dumps and replayed by read(...)
+  void checkpoint(std::string logfile, long fold_interval = 1);
+  void fold(FileH5 &file);
+
   MeasurementHandler operator[](std::string const &quantity) {
     return MeasurementHandler(quantity, *this);
   }
@@ -62,36 +89,96 @@ private:
   std::vector<std::string> fields_;
   std::map<std::string, std::string> type_;
   std::map<std::string, long> previous_dump_;
+  std::map<std::string, long> offset_;
+
+  // The resumed file is opened on the first get(...) of an entry before the
+  // offset and shared by copies
+  std::string resume_filename_;
+  std::string resume_group_;
+  FileH5Options resume_options_;
+  mutable std::shared_ptr<FileH5> resume_file_;
+  FileH5 const &resume_file() const;
+
+  std::string checkpoint_log_;
+  long fold_interval_ = 1;
+  long dumps_since_fold_ = 0;
+  std::map<std::string, long> previous_log_;
+
+  void dump_file(FileH5 &file);
+  void dump_log();
+  void replay_log();
+
+  template <class data_t> inline collector_t<data_t> &collector() {
+    return std::get<collector_t<data_t>>(collectors_);
+  }
 
-  template <class data_t>
-  inline std::map<std::string, std::vector<data_t>> &
-  collector(data_t const &data);
+  template <class data_t> inline collector_t<data_t> const &collector() const {
+    return std::get<collector_t<data_t>>(collectors_);
+  }
 
-  template <class data_t>
-  inline std::map<std::string, std::vector<data_t>> const &
-  collector(data_t const &data) const;
-
-  std::map<std::string, std::vector<int>> collector_i_sca_;
-  std::map<std::string, std::vector<unsigned>> collector_u_sca_;
-  std::map<std::string, std::vector<long>> collector_l_sca_;
-  std::map<std::string, std::vector<unsigned long>> collector_ul_sca_;
-  std::map<std::string, std::vector<long long>> collector_ll_sca_;
-  std::map<std::string, std::vector<unsigned long long>> collector_ull_sca_;
-
-  std::map<std::string, std::vector<sscalar>> collector_s_sca_;
-  std::map<std::string, std::vector<dscalar>> collector_d_sca_;
-  std::map<std::string, std::vector<cscalar>> collector_c_sca_;
-  std::map<std::string, std::vector<zscalar>> collector_z_sca_;
-
-  std::map<std::string, std::vector<svector>> collector_s_vec_;
-  std::map<std::string, std::vector<dvector>> collector_d_vec_;
-  std::map<std::string, std::vector<cvector>> collector_c_vec_;
-  std::map<std::string, std::vector<zvector>> collector_z_vec_;
-
-  std::map<std::string, std::vector<smatrix>> collector_s_mat_;
-  std::map<std::string, std::vector<dmatrix>> collector_d_mat_;
-  std::map<std::string, std::vector<cmatrix>> collector_c_mat_;
-  std::map<std::string, std::vector<zmatrix>> collector_z_mat_;
+  typename collectors_of<lime_field_types>::type collectors_;
 };
+
+template <class data_t>
+void Measurements::append(std::string field, data_t const &data) {
+  std::string type = type_string(data);
+
+  // Create new field if not already present
+  if (!defined(field)) {
+    fields_.push_back(field);
+    type_[field] = type;
+    previous_dump_[field] = (long)0;
+    previous_log_[field] = (long)0;
+    offset_[field] = (long)0;
+  }
+  // Check if type agrees with previously defined type
+  else {
+    if (type != type_[field]) {
+      auto msg = std::string("Lime error: field already defined with "
+                             "different type.");
+      throw std::runtime_error(msg);
+    }
+  }
+
+  // Views of caller memory are collected as their owning type
+  using owner_t = typename owner_of<data_t>::type;
+  if constexpr (std::is_same<owner_t, data_t>::value)
+    collector<data_t>()[field].push_back(data);
+  else
+    collector<owner_t>()[field].push_back(make_owner(data));
+}
+
+template <class data_t>
+void Measurements::get(std::string field, long idx, data_t &data) const {
+  if (defined(field)) {
+    if (type(field) != type_string(data)) {
+      auto msg = std::string("Lime error: cannot get field in "
+                             "measurements. Incompatible types.");
+      throw std::runtime_error(msg);
+    }
+
+    // Entries before the offset are only present in the resumed file
+    long offset = offset_.at(field);
+    if (idx < offset) {
+      resume_file().read(field, idx, data);
+    } else
+      data = collector<data_t>().at(field).at(idx - offset);
+  } else {
+    auto msg = std::string("Lime error: cannot find field in \"get\""
+                           " for measurements.");
+    throw std::runtime_error(msg);
+  }
+}
+
+// Templates of MeasurementHandler need the full definition of Measurements
+template <class data_t> void MeasurementHandler::get(long idx, data_t &data) {
+  measurements_->get(field_, idx, data);
+}
+
+template <class data_t>
+void MeasurementHandler::operator<<(data_t const &data) {
+  measurements_->append(field_, data);
+}
+
 } // namespace lime
 #endif
@@ -0,0 +1,184 @@
+#include "merge.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+
+#include <lime/file_h5.h>
+#include <lime/filesystem.h>
+#include <lime/hdf5/append_compatible.h>
+#include <lime/hdf5/copy_entries.h>
+#include <lime/hdf5/utils.h>
+
+namespace lime {
+
+static void merge_copy(hid_t input_id, std::string field, hid_t output_id,
+                       std::string target) {
+  hid_t link_plist_id = H5Pcreate(H5P_LINK_CREATE);
+  H5Pset_create_intermediate_group(link_plist_id, 1);
+  herr_t status = H5Ocopy(input_id, field.c_str(), output_id, target.c_str(),
+                          H5P_DEFAULT, link_plist_id);
+  H5Pclose(link_plist_id);
+  if (status < 0) {
+    auto msg = std::string("Lime error: can't copy field in merge: ") + field;
+    throw std::runtime_error(msg);
+  }
+}
+
+static void merge_append(hid_t input_id, hid_t output_id, std::string field,
+                         hsize_t buffer_bytes) {
+  hid_t source_id = H5Dopen2(input_id, field.c_str(), H5P_DEFAULT);
+  hid_t datatype_id = H5Dget_type(source_id);
+  auto dims = hdf5::get_dataspace_dims(source_id);
+  std::vector<hsize_t> entry_dims(dims.begin() + 1, dims.end());
+  bool compatible =
+      hdf5::append_compatible(output_id, field, datatype_id, entry_dims);
+  H5Tclose(datatype_id);
+
+  // Matrices need to be stored with the same layout, packed entries need
+  // to hold the same number of values
+  hid_t target_id = H5Dopen2(output_id, field.c_str(), H5P_DEFAULT);
+  if ((hdf5::column_major(source_id) != hdf5::column_major(target_id)) ||
+      (hdf5::bit_count(source_id) != hdf5::bit_count(target_id)))
+    compatible = false;
+  if (!compatible) {
+    H5Dclose(target_id);
+    H5Dclose(source_id);
+    auto msg = std::string("Lime error: can't merge field. Incompatible "
+                           "type/shape/layout: ") +
+               field;
+    throw std::runtime_error(msg);
+  }
+
+  auto new_dims = hdf5::get_dataspace_dims(target_id);
+  hsize_t start = new_dims[0];
+  new_dims[0] += dims[0];
+  H5Dset_extent(target_id, new_dims.data());
+  try {
+    hdf5::copy_entries(source_id, target_id, 0, start, dims[0],
+                       buffer_bytes);
+  } catch (...) {
+    H5Dclose(target_id);
+    H5Dclose(source_id);
+    throw;
+  }
+  H5Dclose(target_id);
+  H5Dclose(source_id);
+}
+
+// Raw content of a static field, empty if it can't be read
+static std::vector<char> merge_content(hid_t dataset_id, hid_t datatype_id) {
+  hid_t space_id = H5Dget_space(dataset_id);
+  hssize_t n_points = H5Sget_simple_extent_npoints(space_id);
+  H5Sclose(space_id);
+  std::vector<char> content(H5Tget_size(datatype_id) *
+                            (n_points > 0 ? n_points : 0));
+  if (!content.empty() &&
+      (H5Dread(dataset_id, datatype_id, H5S_ALL, H5S_ALL, H5P_DEFAULT,
+               content.data()) < 0))
+    content.clear();
+  return content;
+}
+
+static void merge_check_static(hid_t input_id, hid_t output_id,
+                               std::string field) {
+  hid_t source_id = H5Dopen2(input_id, field.c_str(), H5P_DEFAULT);
+  hid_t target_id = H5Dopen2(output_id, field.c_str(), H5P_DEFAULT);
+  hid_t source_type_id = H5Dget_type(source_id);
+  hid_t target_type_id = H5Dget_type(target_id);
+  bool agree =
+      (H5Tequal(source_type_id, target_type_id) > 0) &&
+      (hdf5::get_dataspace_dims(source_id) ==
+       hdf5::get_dataspace_dims(target_id)) &&
+      (merge_content(source_id, source_type_id) ==
+       merge_content(target_id, target_type_id));
+  H5Tclose(target_type_id);
+  H5Tclose(source_type_id);
+  H5Dclose(target_id);
+  H5Dclose(source_id);
+  if (!agree) {
+    auto msg = std::string("Lime error: can't merge static field with "
+                           "different values in inputs: ") +
+               field;
+    throw std::runtime_error(msg);
+  }
+}
+
+void merge(std::vector<std::string> const &inputs, std::string output,
+           MergeOptions const &options) {
+  if (options.stack && !options.labels.empty() &&
+      (options.labels.size() != inputs.size())) {
+    auto msg = std::string("Lime error: number of labels in merge must "
+                           "agree with number of inputs");
+    throw std::runtime_error(msg);
+  }
+
+  if (std::find(inputs.begin(), inputs.end(), output) != inputs.end()) {
+    auto msg = std::string("Lime error: output of merge is one of its "
+                           "inputs: ") +
+               output;
+    throw std::runtime_error(msg);
+  }
+  if (!options.force && exists(output)) {
+    auto msg = std::string("Lime error: output of merge exists, not "
+                           "overwritten unless forced: ") +
+               output;
+    throw std::runtime_error(msg);
+  }
+
+  auto output_file = FileH5(output, options.force ? "w!" : "w");
+  std::map<std::string, bool> merged; // field -> extensible
+
+  // A partially written output is removed, such that merging can be
+  // retried without forcing
+  FileH5 input_file;
+  try {
+    for (std::size_t idx = 0; idx < inputs.size(); ++idx) {
+      input_file = FileH5(inputs[idx], "r");
+      for (auto field : input_file.fields()) {
+        bool extensible = input_file.extensible(field);
+
+        // Stack inputs in separate groups
+        if (options.stack) {
+          std::string label = options.labels.empty() ? std::to_string(idx)
+                                                     : options.labels[idx];
+          merge_copy(input_file.file_id(), field, output_file.file_id(),
+                     label + "/" + field);
+        }
+
+        // First occurrence of a field is copied as a whole
+        else if (merged.find(field) == merged.end()) {
+          merge_copy(input_file.file_id(), field, output_file.file_id(), field);
+          merged[field] = extensible;
+        }
+
+        // Later occurrences of extensible fields are appended
+        else if (merged[field] != extensible) {
+          auto msg = std::string("Lime error: can't merge static with "
+                                 "extensible field: ") +
+                     field;
+          throw std::runtime_error(msg);
+        } else if (extensible)
+          merge_append(input_file.file_id(), output_file.file_id(), field,
+                       options.buffer_bytes);
+
+        // Static fields of later inputs need to agree with the first
+        else
+          merge_check_static(input_file.file_id(), output_file.file_id(),
+                             field);
+      }
+      input_file.close();
+    }
+  } catch (...) {
+    if (input_file)
+      input_file.close();
+    output_file.close();
+    std::remove(output.c_str());
+    throw;
+  }
+  output_file.close();
+}
+
+} // namespace lime
@@ -0,0 +1,44 @@
+// Copyright 2020 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef LIME_MERGE_H
+#define LIME_MERGE_H
+
+#include <hdf5.h>
+#include <string>
+#include <vector>
+
+namespace lime {
+
+struct MergeOptions {
+  bool stack = false;              // copy fields of each input into a group
+  std::vector<std::string> labels; // group names when stacking
+  hsize_t buffer_bytes = 64 << 20; // maximal size of the copy buffer
+  bool force = false;              // overwrite an existing output file
+};
+
+// Merge the lime fields of several files into a new file. By default
+// extensible fields are concatenated in the order of the inputs and static
+// fields, which need to agree in all inputs defining them, are taken from
+// the first one. An existing output file is only overwritten if forced,
+// but never if it is one of the inputs, and a partial output is removed if
+// merging fails. When stacking, the fields of every input are copied into
+// a group named by its label (or its index if no labels are given).
+void merge(std::vector<std::string> const &inputs, std::string output,
+           MergeOptions const &options = MergeOptions());
+
+} // namespace lime
+
+#endif
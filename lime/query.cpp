@@ -0,0 +1,111 @@
+#include "query.h"
+
+#include <cstdlib>
+#include <stdexcept>
+
+#include <hdf5.h>
+
+#include <lime/hdf5/utils.h>
+
+namespace lime {
+
+static bool parse_number(std::string const &text, double &number) {
+  const char *begin = text.c_str();
+  char *end = nullptr;
+  number = std::strtod(begin, &end);
+  if (end == begin)
+    return false;
+  while (*end == ' ')
+    ++end;
+  return *end == '\0';
+}
+
+AttributeQuery::AttributeQuery(std::string field) : field_(field) {}
+
+AttributeQuery &AttributeQuery::equals(std::string attribute_name,
+                                       std::string value) {
+  conditions_.push_back({attribute_name, Kind::text, value, 0., 0.});
+  return *this;
+}
+
+AttributeQuery &AttributeQuery::equals(std::string attribute_name,
+                                       double value, double tolerance) {
+  return between(attribute_name, value - tolerance, value + tolerance);
+}
+
+AttributeQuery &AttributeQuery::between(std::string attribute_name,
+                                        double min, double max) {
+  conditions_.push_back({attribute_name, Kind::number, "", min, max});
+  return *this;
+}
+
+AttributeQuery &AttributeQuery::defines(std::string attribute_name) {
+  conditions_.push_back({attribute_name, Kind::defined, "", 0., 0.});
+  return *this;
+}
+
+bool AttributeQuery::matches(
+    std::map<std::string, std::string> const &attributes) const {
+  for (auto const &condition : conditions_) {
+    auto attribute = attributes.find(condition.attribute_name);
+    if (attribute == attributes.end())
+      return false;
+    double number;
+    if ((condition.kind == Kind::text) &&
+        (attribute->second != condition.value))
+      return false;
+    if ((condition.kind == Kind::number) &&
+        (!parse_number(attribute->second, number) ||
+         (number < condition.min) || (number > condition.max)))
+      return false;
+  }
+  return true;
+}
+
+bool AttributeQuery::matches(std::string filename) const {
+  hid_t file_id;
+  H5E_BEGIN_TRY {
+    file_id = H5Fopen(filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+  }
+  H5E_END_TRY;
+  if (file_id < 0) {
+    auto msg = std::string("Lime error: can't open file for query: ") +
+               filename;
+    throw std::runtime_error(msg);
+  }
+
+  // Groups are checked one after another to open missing fields quietly
+  size_t slash = field_.rfind('/');
+  std::string group =
+      (slash == std::string::npos) ? "" : field_.substr(0, slash);
+  std::string name =
+      (slash == std::string::npos) ? field_ : field_.substr(slash + 1);
+  std::map<std::string, std::string> attributes;
+  bool found = false;
+  hid_t group_id = hdf5::open_group(file_id, group, false);
+  if (group_id >= 0) {
+    if (!name.empty() &&
+        (H5Lexists(group_id, name.c_str(), H5P_DEFAULT) > 0)) {
+      hid_t dataset_id = H5Dopen2(group_id, name.c_str(), H5P_DEFAULT);
+      if (dataset_id >= 0) {
+        attributes = hdf5::get_attribute_values(dataset_id);
+        found = true;
+        H5Dclose(dataset_id);
+      }
+    }
+    H5Gclose(group_id);
+  }
+  H5Fclose(file_id);
+  return found && matches(attributes);
+}
+
+std::vector<std::string>
+AttributeQuery::select(std::vector<std::string> const &filenames) const {
+  std::vector<std::string> selected;
+  for (auto const &filename : filenames)
+    if (matches(filename))
+      selected.push_back(filename);
+  return selected;
+}
+
+} // namespace lime
@@ -0,0 +1,65 @@
+// Copyright 2020 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIME_QUERY_H
+#define LIME_QUERY_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace lime {
+
+// Conditions on the attributes of a field, evaluated on the attributes
+// alone without reading any data of the field. Numeric conditions compare
+// attributes holding a single number, typed or written as text.
+//
+//   AttributeQuery query("energy");
+//   query.equals("model", "heisenberg").between("T", 0.1, 0.5);
+//   auto files = query.select(filenames);
+class AttributeQuery {
+public:
+  explicit AttributeQuery(std::string field);
+
+  AttributeQuery &equals(std::string attribute_name, std::string value);
+  AttributeQuery &equals(std::string attribute_name, double value,
+                         double tolerance = 0.);
+  AttributeQuery &between(std::string attribute_name, double min,
+                          double max);
+  AttributeQuery &defines(std::string attribute_name);
+
+  std::string field() const { return field_; }
+  bool matches(std::map<std::string, std::string> const &attributes) const;
+
+  // Files are opened read-only to read the attributes of the field, files
+  // without the field don't match
+  bool matches(std::string filename) const;
+  std::vector<std::string>
+  select(std::vector<std::string> const &filenames) const;
+
+private:
+  enum class Kind { defined, text, number };
+  struct Condition {
+    std::string attribute_name;
+    Kind kind;
+    std::string value;
+    double min, max;
+  };
+  std::string field_;
+  std::vector<Condition> conditions_;
+};
+
+} // namespace lime
+
+#endif
@@ -0,0 +1,144 @@
+#include "record.h"
+
+#include <tuple>
+
+#include <lime/field_traits.h>
+
+namespace lime {
+
+std::vector<std::string> Record::members() const {
+  std::vector<std::string> names;
+  for (auto const &member : members_)
+    names.push_back(member.name);
+  return names;
+}
+
+bool Record::defined(std::string member) const { return find(member) >= 0; }
+
+std::string Record::type(std::string member) const {
+  long idx = find(member);
+  if (idx < 0) {
+    auto msg = std::string("Lime error: member of record not found: ") +
+               member;
+    throw std::runtime_error(msg);
+  }
+  return members_[idx].type;
+}
+
+hid_t Record::create_datatype() const {
+  hid_t datatype_id = H5Tcreate(H5T_COMPOUND, std::max(nbytes(), (size_t)1));
+  for (auto const &member : members_)
+    H5Tinsert(datatype_id, member.name.c_str(), member.offset,
+              member.datatype);
+  return datatype_id;
+}
+
+namespace {
+
+// Without a type name the first coefficient type with the datatype is used
+template <class coeff_t>
+bool add_member(Record &record, std::string name, std::string const &type,
+                hid_t datatype_id) {
+  if ((type.empty() || (type == coeff_traits<coeff_t>::name())) &&
+      (H5Tequal(datatype_id, hdf5::hdf5_datatype<coeff_t>()) > 0)) {
+    record.set(name, coeff_t());
+    return true;
+  }
+  return false;
+}
+
+template <class... coeff_t>
+bool add_member(Record &record, std::string name, std::string const &type,
+                hid_t datatype_id, std::tuple<coeff_t...> const *) {
+  return (add_member<coeff_t>(record, name, type, datatype_id) || ...);
+}
+
+std::vector<std::string> split_types(std::string const &member_types) {
+  std::vector<std::string> types;
+  size_t start = 0;
+  while (start <= member_types.size()) {
+    size_t end = member_types.find(';', start);
+    if (end == std::string::npos)
+      end = member_types.size();
+    types.push_back(member_types.substr(start, end - start));
+    start = end + 1;
+  }
+  return types;
+}
+
+} // namespace
+
+std::string Record::member_types() const {
+  std::string types;
+  for (size_t idx = 0; idx < members_.size(); ++idx)
+    types += (idx == 0 ? "" : ";") + members_[idx].type;
+  return types;
+}
+
+Record Record::from_datatype(hid_t datatype_id,
+                             std::string const &member_types) {
+  using coeff_types =
+      std::tuple<int, unsigned, long, unsigned long, long long,
+                 unsigned long long, sscalar, dscalar, cscalar, zscalar>;
+  if (H5Tget_class(datatype_id) != H5T_COMPOUND)
+    throw std::runtime_error("Lime error: record datatype is not compound");
+
+  Record record;
+  int n_members = H5Tget_nmembers(datatype_id);
+  std::vector<std::string> types;
+  if (!member_types.empty()) {
+    types = split_types(member_types);
+    if (types.size() != (size_t)n_members)
+      throw std::runtime_error("Lime error: record member types don't match "
+                               "record datatype");
+  }
+  for (int idx = 0; idx < n_members; ++idx) {
+    char *name_c = H5Tget_member_name(datatype_id, (unsigned)idx);
+    std::string name(name_c);
+    H5free_memory(name_c);
+    hid_t member_id = H5Tget_member_type(datatype_id, (unsigned)idx);
+    std::string type = types.empty() ? "" : types[idx];
+    bool known = add_member(record, name, type, member_id,
+                            (coeff_types const *)nullptr);
+    H5Tclose(member_id);
+    if (!known) {
+      auto msg = std::string("Lime error: unknown type of record member: ") +
+                 name;
+      throw std::runtime_error(msg);
+    }
+  }
+  return record;
+}
+
+bool Record::same_members(Record const &other) const {
+  if (members_.size() != other.members_.size())
+    return false;
+  for (size_t idx = 0; idx < members_.size(); ++idx)
+    if ((members_[idx].name != other.members_[idx].name) ||
+        (members_[idx].type != other.members_[idx].type))
+      return false;
+  return true;
+}
+
+bool Record::operator==(Record const &other) const {
+  return same_members(other) && (bytes_ == other.bytes_);
+}
+
+bool Record::operator!=(Record const &other) const {
+  return !operator==(other);
+}
+
+long Record::find(std::string member) const {
+  for (size_t idx = 0; idx < members_.size(); ++idx)
+    if (members_[idx].name == member)
+      return (long)idx;
+  return -1;
+}
+
+void Record::add(std::string member, std::string type, hid_t datatype,
+                 size_t size) {
+  members_.push_back({member, type, datatype, bytes_.size(), size});
+  bytes_.resize(bytes_.size() + size, 0);
+}
+
+} // namespace lime
@@ -0,0 +1,113 @@
+// Copyright 2020 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIME_RECORD_H
+#define LIME_RECORD_H
+
+#include <cstring>
+#include <hdf5.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <lime/hdf5/types.h>
+
+namespace lime {
+
+template <class coeff_t> struct coeff_traits;
+
+// Row of named scalar observables, stored as a single entry of a compound
+// field with the names as members. Members are added by their first set
+// and keep their coefficient type.
+class Record {
+public:
+  Record() = default;
+
+  template <class coeff_t> void set(std::string member, coeff_t value);
+  template <class coeff_t> coeff_t get(std::string member) const;
+
+  std::vector<std::string> members() const;
+  bool defined(std::string member) const;
+  std::string type(std::string member) const;
+
+  inline size_t nbytes() const { return bytes_.size(); }
+  inline char *data() { return bytes_.data(); }
+  inline const char *data() const { return bytes_.data(); }
+
+  // Compound datatype of the members, needs to be closed
+  hid_t create_datatype() const;
+
+  // Coefficient types of the members separated by ";". Integer types of
+  // equal size share an hdf5 datatype, so they are stored alongside it.
+  std::string member_types() const;
+
+  // Record with the members of a compound datatype (set to zero), typed as
+  // in member_types if given
+  static Record from_datatype(hid_t datatype_id,
+                              std::string const &member_types = "");
+
+  bool same_members(Record const &other) const;
+  bool operator==(Record const &other) const;
+  bool operator!=(Record const &other) const;
+
+private:
+  struct Member {
+    std::string name;
+    std::string type;
+    hid_t datatype; // not owned
+    size_t offset;
+    size_t size;
+  };
+  std::vector<Member> members_;
+  std::vector<char> bytes_;
+
+  long find(std::string member) const;
+  void add(std::string member, std::string type, hid_t datatype, size_t size);
+};
+
+template <class coeff_t> void Record::set(std::string member, coeff_t value) {
+  long idx = find(member);
+  if (idx < 0) {
+    add(member, coeff_traits<coeff_t>::name(), hdf5::hdf5_datatype<coeff_t>(),
+        sizeof(coeff_t));
+    idx = (long)members_.size() - 1;
+  } else if (members_[idx].type != coeff_traits<coeff_t>::name()) {
+    auto msg = std::string("Lime error: member of record already defined "
+                           "with different type: ") +
+               member;
+    throw std::runtime_error(msg);
+  }
+  std::memcpy(bytes_.data() + members_[idx].offset, &value, sizeof(coeff_t));
+}
+
+template <class coeff_t> coeff_t Record::get(std::string member) const {
+  long idx = find(member);
+  if ((idx < 0) || (members_[idx].type != coeff_traits<coeff_t>::name())) {
+    auto msg = std::string("Lime error: no member of record with given "
+                           "name and type: ") +
+               member;
+    throw std::runtime_error(msg);
+  }
+  coeff_t value;
+  std::memcpy(&value, bytes_.data() + members_[idx].offset, sizeof(coeff_t));
+  return value;
+}
+
+} // namespace lime
+
+// Coefficient traits are needed by the member templates, the field traits
+// of records in turn need their full definition
+#include <lime/field_traits.h>
+
+#endif
@@ -0,0 +1,137 @@
+#include "repack.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+#include <vector>
+
+#include <lime/file_h5.h>
+#include <lime/hdf5/copy_entries.h>
+#include <lime/hdf5/utils.h>
+
+namespace lime {
+
+static hid_t repack_create_plist(std::vector<hsize_t> const &dims,
+                                 hsize_t entry_bytes,
+                                 RepackOptions const &options) {
+  hid_t plist_id = H5Pcreate(H5P_DATASET_CREATE);
+  if (options.contiguous) {
+    H5Pset_layout(plist_id, H5D_CONTIGUOUS);
+    return plist_id;
+  }
+
+  // Chunks cover whole entries, number of entries set by chunk size. Short
+  // fields keep the full chunk size, such that later appends fill it.
+  hsize_t chunk_size = options.chunk_size;
+  if (chunk_size == 0)
+    chunk_size = std::max((hsize_t)1, options.chunk_bytes / entry_bytes);
+  std::vector<hsize_t> chunk_dims = dims;
+  chunk_dims[0] = chunk_size;
+  herr_t status;
+  H5E_BEGIN_TRY {
+    status = H5Pset_chunk(plist_id, (int)chunk_dims.size(), chunk_dims.data());
+  }
+  H5E_END_TRY;
+  if (status < 0) {
+    H5Pclose(plist_id);
+    auto msg = std::string("Lime error: invalid chunk size in repack: ") +
+               std::to_string(chunk_size);
+    throw std::runtime_error(msg);
+  }
+
+  if (options.compression > 0) {
+    H5Pset_shuffle(plist_id);
+    H5Pset_deflate(plist_id, options.compression);
+  }
+  return plist_id;
+}
+
+static void repack_field(hid_t input_id, hid_t output_id, std::string field,
+                         bool extensible, RepackOptions const &options) {
+  hid_t source_id = H5Dopen2(input_id, field.c_str(), H5P_DEFAULT);
+  hid_t datatype_id = H5Dget_type(source_id);
+  auto dims = hdf5::get_dataspace_dims(source_id);
+  hsize_t entry_bytes = H5Tget_size(datatype_id);
+  for (std::size_t d = 1; d < dims.size(); ++d)
+    entry_bytes *= dims[d];
+
+  // Static fields are copied as they are
+  hid_t plist_id = H5P_DEFAULT;
+  auto max_dims = dims;
+  if (extensible) {
+    try {
+      plist_id = repack_create_plist(dims, entry_bytes, options);
+    } catch (...) {
+      H5Tclose(datatype_id);
+      H5Dclose(source_id);
+      throw;
+    }
+    if (!options.contiguous)
+      max_dims[0] = H5S_UNLIMITED;
+  }
+
+  hid_t link_plist_id = H5Pcreate(H5P_LINK_CREATE);
+  H5Pset_create_intermediate_group(link_plist_id, 1);
+  hid_t dataspace_id =
+      H5Screate_simple((int)dims.size(), dims.data(), max_dims.data());
+  hid_t target_id = H5Dcreate2(output_id, field.c_str(), datatype_id,
+                               dataspace_id, link_plist_id, plist_id,
+                               H5P_DEFAULT);
+  H5Sclose(dataspace_id);
+  H5Pclose(link_plist_id);
+  if (plist_id != H5P_DEFAULT)
+    H5Pclose(plist_id);
+  if (target_id < 0) {
+    H5Tclose(datatype_id);
+    H5Dclose(source_id);
+    auto msg = std::string("Lime error: can't create field in repack: ") +
+               field;
+    throw std::runtime_error(msg);
+  }
+
+  // Copy data in blocks of entries with bounded memory
+  try {
+    if ((dims.size() > 0) && (entry_bytes > 0))
+      hdf5::copy_entries(source_id, target_id, 0, 0, dims[0],
+                         options.buffer_bytes);
+  } catch (...) {
+    H5Dclose(target_id);
+    H5Tclose(datatype_id);
+    H5Dclose(source_id);
+    throw;
+  }
+
+  hdf5::copy_attributes(source_id, target_id);
+  H5Dclose(target_id);
+  H5Tclose(datatype_id);
+  H5Dclose(source_id);
+}
+
+void repack(std::string input, std::string output,
+            RepackOptions const &options) {
+  if (options.contiguous && (options.compression > 0)) {
+    auto msg = std::string("Lime error: compression in repack requires "
+                           "chunked fields");
+    throw std::runtime_error(msg);
+  }
+
+  auto input_file = FileH5(input, "r", options.group);
+  auto output_file = FileH5(output, "w!", options.file, options.group);
+
+  // A partially written output is removed, such that repacking can be
+  // retried (e.g. in place via the same temporary file)
+  try {
+    for (auto field : input_file.fields())
+      repack_field(input_file.file_id(), output_file.file_id(), field,
+                   input_file.extensible(field), options);
+  } catch (...) {
+    output_file.close();
+    input_file.close();
+    std::remove(output.c_str());
+    throw;
+  }
+  output_file.close();
+  input_file.close();
+}
+
+} // namespace lime
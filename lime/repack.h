@@ -0,0 +1,46 @@
+// Copyright 2020 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef LIME_REPACK_H
+#define LIME_REPACK_H
+
+#include <hdf5.h>
+#include <string>
+
+#include <lime/file_h5_options.h>
+
+namespace lime {
+
+struct RepackOptions {
+  hsize_t chunk_bytes = 1 << 20;   // target size of chunks in bytes
+  hsize_t chunk_size = 0;          // entries per chunk, overrides chunk_bytes
+  int compression = 0;             // deflate level, 0 means no compression
+  bool contiguous = false;         // store extensible fields contiguously
+  hsize_t buffer_bytes = 64 << 20; // maximal size of the copy buffer
+  std::string group;               // only repack the fields of this group
+  FileH5Options file;              // creation/access options of the output
+};
+
+// Rewrite all lime fields of a file with the layout given by options.
+// Contiguous extensible fields can be read and mapped, but not appended to.
+// If a group is given, only its fields are written to the same group of
+// the output file, other objects of the input are not copied. If repacking
+// fails, the partially written output is removed.
+void repack(std::string input, std::string output,
+            RepackOptions const &options = RepackOptions());
+
+} // namespace lime
+
+#endif
@@ -0,0 +1,82 @@
+// Copyright 2020 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIME_TENSOR_H
+#define LIME_TENSOR_H
+
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+namespace lime {
+
+// Dense tensor of arbitrary rank with coefficients stored row-major, i.e.
+// the last index runs fastest as in the dimensions of an hdf5 dataset. A
+// tensor of rank zero holds a single coefficient.
+template <class coeff_t> class Tensor {
+public:
+  using size_type = int64_t;
+
+  Tensor() = default;
+  explicit Tensor(std::vector<size_type> const &shape) { resize(shape); }
+
+  inline std::vector<size_type> const &shape() const { return shape_; }
+  inline size_type rank() const { return (size_type)shape_.size(); }
+  inline size_type size() const { return (size_type)data_.size(); }
+  inline coeff_t *data() { return data_.data(); }
+  inline coeff_t const *data() const { return data_.data(); }
+
+  inline void resize(std::vector<size_type> const &shape) {
+    shape_ = shape;
+    size_type size = 1;
+    for (auto dim : shape)
+      size *= dim;
+    data_.resize(size);
+  }
+  inline void clear() {
+    shape_.clear();
+    data_.clear();
+  }
+
+  template <class... index_t> inline coeff_t &operator()(index_t... idx) {
+    return data_[offset({(size_type)idx...})];
+  }
+  template <class... index_t>
+  inline coeff_t const &operator()(index_t... idx) const {
+    return data_[offset({(size_type)idx...})];
+  }
+
+  inline bool operator==(Tensor const &other) const {
+    return (shape_ == other.shape_) && (data_ == other.data_);
+  }
+  inline bool operator!=(Tensor const &other) const {
+    return !operator==(other);
+  }
+
+private:
+  std::vector<size_type> shape_;
+  std::vector<coeff_t> data_;
+
+  inline size_type offset(std::initializer_list<size_type> idx) const {
+    size_type offset = 0;
+    auto dim = shape_.begin();
+    for (auto i : idx)
+      offset = offset * (*dim++) + i;
+    return offset;
+  }
+};
+
+} // namespace lime
+
+#endif
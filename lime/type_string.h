@@ -15,106 +15,23 @@
 #ifndef LIME_HDF5_TYPE_STRING_H
 #define LIME_HDF5_TYPE_STRING_H
 
-#include <array>
-#include <complex>
-#include <hdf5.h>
 #include <string>
+#include <vector>
 
-#include <lime/types.h>
+#include <lime/field_traits.h>
 
 namespace lime {
 
-const std::vector<std::string> all_lime_field_types{
-    "IntScalar",          "UintScalar",          "LongScalar",  "UlongScalar",
-    "LlongScalar",        "UllongScalar",        "FloatScalar", "DoubleScalar",
-    "ComplexFloatScalar", "ComplexDoubleScalar", "FloatVector", "DoubleVector",
-    "ComplexFloatVector", "ComplexDoubleVector", "FloatMatrix", "DoubleMatrix",
-    "ComplexFloatMatrix", "ComplexDoubleMatrix"};
+const std::vector<std::string> all_lime_field_types =
+    field_type_strings((lime_field_types const *)nullptr);
 
-inline std::string type_string(int const &) { return "IntScalar"; }
-inline std::string type_string(unsigned const &) { return "UintScalar"; }
-inline std::string type_string(long const &) { return "LongScalar"; }
-inline std::string type_string(unsigned long const &) { return "UlongScalar"; }
-inline std::string type_string(long long const &) { return "LlongScalar"; }
-inline std::string type_string(unsigned long long const &) {
-  return "UllongScalar";
+template <class data_t> inline std::string type_string(data_t const &) {
+  return field_type_string<data_t>();
 }
 
-inline std::string type_string(sscalar const &) { return "FloatScalar"; }
-inline std::string type_string(dscalar const &) { return "DoubleScalar"; }
-inline std::string type_string(cscalar const &) { return "ComplexFloatScalar"; }
-inline std::string type_string(zscalar const &) {
-  return "ComplexDoubleScalar";
-}
-
-inline std::string type_string(svector const &) { return "FloatVector"; }
-inline std::string type_string(dvector const &) { return "DoubleVector"; }
-inline std::string type_string(cvector const &) { return "ComplexFloatVector"; }
-inline std::string type_string(zvector const &) {
-  return "ComplexDoubleVector";
-}
-
-inline std::string type_string(smatrix const &) { return "FloatMatrix"; }
-inline std::string type_string(dmatrix const &) { return "DoubleMatrix"; }
-inline std::string type_string(cmatrix const &) { return "ComplexFloatMatrix"; }
-inline std::string type_string(zmatrix const &) {
-  return "ComplexDoubleMatrix";
-}
-
-inline std::string type_string(std::vector<int> const &) { return "IntScalar"; }
-inline std::string type_string(std::vector<unsigned int> const &) {
-  return "UintScalar";
-}
-inline std::string type_string(std::vector<long> const &) {
-  return "LongScalar";
-}
-inline std::string type_string(std::vector<unsigned long> const &) {
-  return "UlongScalar";
-}
-inline std::string type_string(std::vector<long long> const &) {
-  return "LlongScalar";
-}
-inline std::string type_string(std::vector<unsigned long long> const &) {
-  return "UllongScalar";
-}
-
-inline std::string type_string(std::vector<sscalar> const &) {
-  return "FloatScalar";
-}
-inline std::string type_string(std::vector<dscalar> const &) {
-  return "DoubleScalar";
-}
-inline std::string type_string(std::vector<cscalar> const &) {
-  return "ComplexFloatScalar";
-}
-inline std::string type_string(std::vector<zscalar> const &) {
-  return "ComplexDoubleScalar";
-}
-
-inline std::string type_string(std::vector<svector> const &) {
-  return "FloatVector";
-}
-inline std::string type_string(std::vector<dvector> const &) {
-  return "DoubleVector";
-}
-inline std::string type_string(std::vector<cvector> const &) {
-  return "ComplexFloatVector";
-}
-inline std::string type_string(std::vector<zvector> const &) {
-  return "ComplexDoubleVector";
-}
-
-inline std::string type_string(std::vector<smatrix> const &) {
-  return "FloatMatrix";
-}
-inline std::string type_string(std::vector<dmatrix> const &) {
-  return "DoubleMatrix";
-}
-inline std::string type_string(std::vector<cmatrix> const &) {
-  return "ComplexFloatMatrix";
-}
-inline std::string type_string(std::vector<zmatrix> const &) {
-  return "ComplexDoubleMatrix";
+template <class data_t>
+inline std::string type_string(std::vector<data_t> const &) {
+  return field_type_string<data_t>();
 }
 
 } // namespace lime
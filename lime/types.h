@@ -17,6 +17,8 @@
 
 #include <complex>
 #include <lila/all.h>
+#include <lime/bool_vector.h>
+#include <lime/tensor.h>
 
 namespace lime
 {
@@ -35,6 +37,34 @@ namespace lime
   using cmatrix = lila::Matrix<std::complex<float>>;
   using zmatrix = lila::Matrix<std::complex<double>>;
 
+  using ivector = lila::Vector<int>;
+  using uvector = lila::Vector<unsigned>;
+  using lvector = lila::Vector<long>;
+  using ulvector = lila::Vector<unsigned long>;
+  using llvector = lila::Vector<long long>;
+  using ullvector = lila::Vector<unsigned long long>;
+
+  using imatrix = lila::Matrix<int>;
+  using umatrix = lila::Matrix<unsigned>;
+  using lmatrix = lila::Matrix<long>;
+  using ulmatrix = lila::Matrix<unsigned long>;
+  using llmatrix = lila::Matrix<long long>;
+  using ullmatrix = lila::Matrix<unsigned long long>;
+
+  using bvector = BoolVector;
+
+  using itensor = Tensor<int>;
+  using utensor = Tensor<unsigned>;
+  using ltensor = Tensor<long>;
+  using ultensor = Tensor<unsigned long>;
+  using lltensor = Tensor<long long>;
+  using ulltensor = Tensor<unsigned long long>;
+
+  using stensor = Tensor<float>;
+  using dtensor = Tensor<double>;
+  using ctensor = Tensor<std::complex<float>>;
+  using ztensor = Tensor<std::complex<double>>;
+
 }
 
 #endif
@@ -0,0 +1,96 @@
+// Copyright 2020 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIME_VIEW_H
+#define LIME_VIEW_H
+
+#include <cstdint>
+#include <vector>
+
+namespace lime {
+
+// Non-owning views of memory of the caller, which can be written and
+// appended to fields of the corresponding vector/matrix/tensor types
+// without copying the data into a lime/lila object first. The memory needs
+// to stay valid while the view is used.
+template <class coeff_t> class VectorView {
+public:
+  using size_type = int64_t;
+
+  VectorView(coeff_t const *data, size_type size) : data_(data), size_(size) {}
+  VectorView(std::vector<coeff_t> const &vector)
+      : data_(vector.data()), size_((size_type)vector.size()) {}
+
+  inline size_type size() const { return size_; }
+  inline coeff_t const *data() const { return data_; }
+
+private:
+  coeff_t const *data_;
+  size_type size_;
+};
+
+// Matrix entries are expected column-major as in lila::Matrix
+template <class coeff_t> class MatrixView {
+public:
+  using size_type = int64_t;
+
+  MatrixView(coeff_t const *data, size_type nrows, size_type ncols)
+      : data_(data), nrows_(nrows), ncols_(ncols) {}
+
+  inline size_type nrows() const { return nrows_; }
+  inline size_type ncols() const { return ncols_; }
+  inline coeff_t const *data() const { return data_; }
+
+private:
+  coeff_t const *data_;
+  size_type nrows_;
+  size_type ncols_;
+};
+
+// Tensor entries are expected row-major as in lime::Tensor
+template <class coeff_t> class TensorView {
+public:
+  using size_type = int64_t;
+
+  TensorView(coeff_t const *data, std::vector<size_type> const &shape)
+      : data_(data), shape_(shape) {}
+
+  inline std::vector<size_type> const &shape() const { return shape_; }
+  inline coeff_t const *data() const { return data_; }
+
+private:
+  coeff_t const *data_;
+  std::vector<size_type> shape_;
+};
+
+template <class coeff_t>
+inline VectorView<coeff_t> view(coeff_t const *data, int64_t size) {
+  return VectorView<coeff_t>(data, size);
+}
+
+template <class coeff_t>
+inline MatrixView<coeff_t> view(coeff_t const *data, int64_t nrows,
+                                int64_t ncols) {
+  return MatrixView<coeff_t>(data, nrows, ncols);
+}
+
+template <class coeff_t>
+inline TensorView<coeff_t> view(coeff_t const *data,
+                                std::vector<int64_t> const &shape) {
+  return TensorView<coeff_t>(data, shape);
+}
+
+} // namespace lime
+
+#endif
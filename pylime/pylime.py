@@ -16,6 +16,33 @@ import h5py
 import copy
 
 
+def read_field(dataset):
+    """ Read a lime field from a h5py dataset
+    
+    Matrices are stored column-major by lime, such that the last two axes
+    need to be swapped to obtain the matrix in numpy (row-major) order.
+    BoolVectors are stored as bytes holding eight values each (least
+    significant bit first) and are unpacked to boolean arrays.
+
+    Args:
+        dataset (h5py.Dataset): dataset of the field
+    Returns:
+        np.array:   values of the field
+    """
+    values = dataset[()]
+    layout = dataset.attrs.get("LimeFieldLayout", b"")
+    if isinstance(layout, bytes):
+        layout = layout.decode()
+    if layout == "ColumnMajor":
+        values = np.swapaxes(values, -1, -2)
+    bit_count = dataset.attrs.get("LimeFieldBitCount", None)
+    if bit_count is not None:
+        if isinstance(bit_count, bytes):
+            bit_count = bit_count.decode()
+        values = np.unpackbits(values, axis=-1, bitorder="little")
+        values = values[..., :int(bit_count)].astype(bool)
+    return values
+
 def read_data(directory, regex, quantities, verbose=True):
     """ Read data for various seeds and quantities using regular expression
     
@@ -50,7 +77,8 @@ def read_data(directory, regex, quantities, verbose=True):
 
         for quantity in quantities:
             if quantity in hf.keys():
-                values_of_quantity_seed[quantity][seed] = hf[quantity][:] 
+                values_of_quantity_seed[quantity][seed] = \
+                    read_field(hf[quantity])
             else:
                 print("Couldn't find \"{}\" in seed {}".format(quantity, seed))
    
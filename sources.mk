@@ -3,9 +3,19 @@ sources+= lime/file_h5_handler.cpp
 sources+= lime/measurements.cpp
 sources+= lime/measurement_handler.cpp
 sources+= lime/filesystem.cpp
+sources+= lime/append_log.cpp
+sources+= lime/mapped_field.cpp
+sources+= lime/repack.cpp
+sources+= lime/merge.cpp
+sources+= lime/bool_vector.cpp
+sources+= lime/record.cpp
+sources+= lime/io_stats.cpp
+sources+= lime/query.cpp
+sources+= lime/catalog.cpp
 
 sources+= lime/hdf5/utils.cpp
 sources+= lime/hdf5/parse_file.cpp
+sources+= lime/hdf5/copy_entries.cpp
 sources+= lime/hdf5/create_static_field.cpp
 sources+= lime/hdf5/read_static_compatible.cpp
 sources+= lime/hdf5/read_static_field.cpp
@@ -15,12 +25,46 @@ sources+= lime/hdf5/write_static_field.cpp
 sources+= lime/hdf5/create_extensible_field.cpp
 sources+= lime/hdf5/read_extensible_compatible.cpp
 sources+= lime/hdf5/read_extensible_field.cpp
+sources+= lime/hdf5/read_extensible_element.cpp
 sources+= lime/hdf5/append_compatible.cpp
 sources+= lime/hdf5/append_extensible_field.cpp
+sources+= lime/hdf5/read_hyperslab.cpp
+sources+= lime/hdf5/read_into.cpp
+sources+= lime/hdf5/read_member.cpp
+sources+= lime/hdf5/field_scope.cpp
+sources+= lime/hdf5/chunk_filters.cpp
+sources+= lime/hdf5/read_entries.cpp
+sources+= lime/hdf5/write_entries.cpp
 
 testsources+= test/tests.cpp
 testsources+= test/test_file_h5.cpp
 testsources+= test/test_file_h5_rdwr.cpp
 testsources+= test/test_file_h5_append.cpp
 testsources+= test/test_file_h5_attribute.cpp
+testsources+= test/test_file_h5_map.cpp
+testsources+= test/test_file_h5_integer.cpp
+testsources+= test/test_file_h5_tensor.cpp
+testsources+= test/test_file_h5_storage.cpp
+testsources+= test/test_file_h5_view.cpp
+testsources+= test/test_file_h5_read_into.cpp
+testsources+= test/test_file_h5_record.cpp
+testsources+= test/test_file_h5_group.cpp
+testsources+= test/test_file_h5_stats.cpp
+testsources+= test/test_file_h5_chunk_cache.cpp
+testsources+= test/test_file_h5_options.cpp
+testsources+= test/test_file_h5_memory.cpp
+testsources+= test/test_query.cpp
+testsources+= test/test_catalog.cpp
 testsources+= test/test_measurements.cpp
+testsources+= test/test_measurements_checkpoint.cpp
+testsources+= test/test_merge.cpp
+testsources+= test/test_repack.cpp
+testsources+= test/test_write_entries.cpp
+
+toolsources+= tools/lime_repack.cpp
+toolsources+= tools/lime_merge.cpp
+toolsources+= tools/lime_catalog.cpp
+
+benchsources+= bench/benchmarks.cpp
+benchsources+= bench/bench_file_h5.cpp
+benchsources+= bench/bench_measurements.cpp
@@ -0,0 +1,93 @@
+// Copyright 2020 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+
+#include <lime/all.h>
+
+TEST_CASE("catalog", "[catalog]") {
+  std::vector<std::string> filenames;
+  for (int L : {8, 12, 16})
+    for (int seed : {1, 2}) {
+      std::string filename = "test_catalog_" + std::to_string(L) + "_" +
+                             std::to_string(seed) + ".h5";
+      remove(filename.c_str());
+      auto file = lime::FileH5(filename, "w");
+      for (int idx = 0; idx < L; ++idx)
+        file["energy"] << (double)idx;
+      file["energy"].set_attribute("L", L);
+      file["energy"].set_attribute("seed", seed);
+      file["energy"].set_attribute("model", "heisenberg");
+      file["group/J"] = 1.0;
+      file.close();
+      filenames.push_back(filename);
+    }
+
+  lime::Catalog catalog;
+  for (auto const &filename : filenames)
+    catalog.add(filename);
+  REQUIRE(catalog.entries().size() == 12);
+  REQUIRE(catalog.filenames() == filenames);
+  catalog.add(filenames[0]);
+  REQUIRE(catalog.entries().size() == 12);
+
+  std::string catalog_filename = "test_catalog.h5";
+  catalog.write(catalog_filename);
+
+  // Queries are answered without the lime files
+  std::vector<std::string> removed;
+  for (auto const &filename : filenames) {
+    rename(filename.c_str(), (filename + ".moved").c_str());
+    removed.push_back(filename + ".moved");
+  }
+  auto read = lime::Catalog(catalog_filename);
+  REQUIRE(read.entries().size() == 12);
+  REQUIRE(read.filenames() == catalog.filenames());
+  auto query = lime::AttributeQuery("energy");
+  query.between("L", 10, 20).equals("seed", 2);
+  auto entries = read.select(query);
+  REQUIRE(entries.size() == 2);
+  for (auto const &entry : entries) {
+    REQUIRE(entry.type == "DoubleScalar");
+    REQUIRE(entry.extensible);
+    REQUIRE(entry.size == std::stol(entry.attributes.at("L")));
+    REQUIRE(entry.attributes.at("model") == "heisenberg");
+    REQUIRE(entry.attributes.count(LIME_FIELD_TYPE_STRING) == 0);
+  }
+  REQUIRE(read.filenames(query) ==
+          std::vector<std::string>({filenames[3], filenames[5]}));
+  auto fields = read.select(lime::AttributeQuery("group/J"));
+  REQUIRE(fields.size() == 6);
+  REQUIRE(!fields[0].extensible);
+  REQUIRE(fields[0].size == 1);
+  REQUIRE(read.select(lime::AttributeQuery("undefined")).empty());
+
+  read.remove(filenames[1]);
+  REQUIRE(read.entries().size() == 10);
+  REQUIRE(read.filenames(lime::AttributeQuery("energy").equals("L", 8)) ==
+          std::vector<std::string>({filenames[0]}));
+
+  // Empty catalogs and files which aren't catalogs
+  lime::Catalog().write(catalog_filename);
+  REQUIRE(lime::Catalog(catalog_filename).entries().empty());
+  REQUIRE_THROWS(lime::Catalog(removed[0]));
+  REQUIRE_THROWS(lime::Catalog("test_catalog_missing.h5"));
+
+  for (auto const &filename : removed)
+    remove(filename.c_str());
+  remove(catalog_filename.c_str());
+}
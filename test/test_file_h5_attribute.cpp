@@ -14,6 +14,7 @@
 
 #include <complex>
 #include <iostream>
+#include <map>
 #include <stdio.h>
 
 #include "catch.hpp"
@@ -86,7 +87,145 @@ template <class data_t> void test_file_h5_attribute_matrix() {
   remove(filename.c_str());
 }
 
+void test_file_h5_attributes() {
+  std::string filename = "test_file.h5";
+  remove(filename.c_str());
+
+  std::map<std::string, std::string> parameters;
+  for (int idx = 0; idx < 30; ++idx)
+    parameters["parameter" + std::to_string(idx)] = std::to_string(idx);
+  parameters["empty"] = "";
+  auto file = lime::FileH5(filename, "w");
+  file["energy"] << 1.0;
+  file["energy"].set_attributes(parameters);
+  file["energy"].set_attributes({{"parameter3", "changed"}});
+  parameters["parameter3"] = "changed";
+  auto attributes = file["energy"].attributes();
+  REQUIRE(attributes.size() == parameters.size() + 2);
+  REQUIRE(attributes[LIME_FIELD_TYPE_STRING] == "DoubleScalar");
+  REQUIRE(attributes[LIME_FIELD_STATIC_EXTENSIBLE_STRING] == "Extensible");
+  REQUIRE(file["energy"].attribute("empty") == "");
+  REQUIRE(file["energy"].has_attribute(LIME_FIELD_TYPE_STRING));
+  REQUIRE(!file["energy"].has_attribute(LIME_FIELD_BIT_COUNT_STRING));
+  REQUIRE_THROWS(file["energy"].attribute(LIME_FIELD_BIT_COUNT_STRING));
+  REQUIRE_THROWS(file["undefined"].attributes());
+
+  // Cached attributes follow changes
+  file["energy"].set_attribute(LIME_FIELD_STATS_STRING, "stats");
+  REQUIRE(file["energy"].attribute(LIME_FIELD_STATS_STRING) == "stats");
+  file.close();
+
+  file = lime::FileH5(filename, "r");
+  attributes = file["energy"].attributes();
+  for (auto const &parameter : parameters)
+    REQUIRE(attributes[parameter.first] == parameter.second);
+  REQUIRE(attributes[LIME_FIELD_STATS_STRING] == "stats");
+  file.close();
+
+  // Variable length string attributes, e.g. written by h5py
+  hid_t file_id = H5Fopen(filename.c_str(), H5F_ACC_RDWR, H5P_DEFAULT);
+  hid_t dataset_id = H5Dopen2(file_id, "energy", H5P_DEFAULT);
+  hid_t type_id = H5Tcopy(H5T_C_S1);
+  H5Tset_size(type_id, H5T_VARIABLE);
+  hid_t space_id = H5Screate(H5S_SCALAR);
+  hid_t attribute_id = H5Acreate2(dataset_id, "variable", type_id, space_id,
+                                  H5P_DEFAULT, H5P_DEFAULT);
+  const char *value = "variable length";
+  H5Awrite(attribute_id, type_id, &value);
+  H5Aclose(attribute_id);
+  H5Sclose(space_id);
+  H5Tclose(type_id);
+  H5Dclose(dataset_id);
+  H5Fclose(file_id);
+  file = lime::FileH5(filename, "r");
+  REQUIRE(file["energy"].attribute("variable") == "variable length");
+  REQUIRE(file["energy"].attributes()["variable"] == "variable length");
+  file.close();
+  remove(filename.c_str());
+}
+
+template <class coeff_t> void test_file_h5_attribute_typed() {
+  std::string filename = "test_file.h5";
+  remove(filename.c_str());
+
+  coeff_t val1 = (coeff_t)42;
+  std::vector<coeff_t> vec1 = {(coeff_t)1, (coeff_t)2, (coeff_t)3};
+  auto file = lime::FileH5(filename, "w");
+  file["test"] = 1.0;
+  file["test"].set_attribute("scalar", val1);
+  file["test"].set_attribute("vector", vec1);
+  file["test"].set_attribute("empty", std::vector<coeff_t>());
+  file.close();
+
+  file = lime::FileH5(filename, "r");
+  coeff_t val2;
+  std::vector<coeff_t> vec2;
+  file["test"].attribute("scalar", val2);
+  REQUIRE(val2 == val1);
+  file["test"].attribute("vector", vec2);
+  REQUIRE(vec2 == vec1);
+  file["test"].attribute("empty", vec2);
+  REQUIRE(vec2.empty());
+  file["test"].attribute("scalar", vec2);
+  REQUIRE(vec2 == std::vector<coeff_t>({val1}));
+  REQUIRE_THROWS(file["test"].attribute("vector", val2));
+  REQUIRE_THROWS(file["test"].attribute("undefined", val2));
+  file.close();
+  remove(filename.c_str());
+}
+
+void test_file_h5_attribute_parameters() {
+  std::string filename = "test_file.h5";
+  remove(filename.c_str());
+
+  auto file = lime::FileH5(filename, "w");
+  file["energy"] << 1.0;
+  file["energy"].set_attribute("L", 16);
+  file["energy"].set_attribute("T", 0.1);
+  file["energy"].set_attribute("seed", 12345678901234ULL);
+  file["energy"].set_attribute("J", std::complex<double>(1.0, -0.5));
+  file["energy"].set_attribute("model", "heisenberg");
+  file.close();
+
+  // Integers and floating point numbers convert into each other, complex
+  // numbers and strings don't
+  file = lime::FileH5(filename, "r");
+  double L;
+  int T;
+  std::complex<double> J;
+  file["energy"].attribute("L", L);
+  REQUIRE(L == 16.0);
+  file["energy"].attribute("T", T);
+  REQUIRE(T == 0);
+  file["energy"].attribute("J", J);
+  REQUIRE(J == std::complex<double>(1.0, -0.5));
+  REQUIRE_THROWS(file["energy"].attribute("J", L));
+  REQUIRE_THROWS(file["energy"].attribute("L", J));
+  REQUIRE_THROWS(file["energy"].attribute("model", L));
+  REQUIRE_THROWS(file["undefined"].attribute("L", L));
+
+  // Typed attributes read as text
+  REQUIRE(file["energy"].attribute("L") == "16");
+  REQUIRE(file["energy"].attribute("T") == "0.1");
+  REQUIRE(file["energy"].attribute("seed") == "12345678901234");
+  REQUIRE(file["energy"].attribute("J") == "(1,-0.5)");
+  REQUIRE(file["energy"].attributes()["L"] == "16");
+  REQUIRE(file["energy"].attribute("model") == "heisenberg");
+  file.close();
+  remove(filename.c_str());
+}
+
 TEST_CASE("file_h5_attribute", "[file]") {
+  test_file_h5_attribute_parameters();
+  test_file_h5_attribute_typed<int>();
+  test_file_h5_attribute_typed<unsigned long long>();
+  test_file_h5_attribute_typed<float>();
+  test_file_h5_attribute_typed<double>();
+  test_file_h5_attribute_typed<std::complex<float>>();
+  test_file_h5_attribute_typed<std::complex<double>>();
+
+  test_file_h5_attributes();
+
   test_file_h5_attribute_scalar<int>();
   test_file_h5_attribute_scalar<unsigned int>();
   test_file_h5_attribute_scalar<long>();
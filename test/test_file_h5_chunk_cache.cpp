@@ -0,0 +1,137 @@
+// Copyright 2020 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cmath>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+
+#include <lime/all.h>
+
+using namespace lime;
+
+TEST_CASE("file_h5_chunk_cache", "[file]") {
+  std::string filename = "test_file.h5";
+  remove(filename.c_str());
+
+  auto vec = lila::Random<double>(50);
+  auto file = FileH5(filename, "w");
+  file.collect_stats();
+  file["scaled"].set_storage(FieldStorage(FieldStorage::Native, 3));
+  file["scalars"] << 0.0;
+  file["scaled"] << vec;
+  long scalar_opens = file.stats("scalars").dataset_opens;
+  long scaled_opens = file.stats("scaled").dataset_opens;
+  for (int idx = 1; idx < 100; ++idx) {
+    file["scalars"] << (double)idx;
+    file["scaled"] << vec;
+  }
+
+  // Appended datasets stay open between appends
+  REQUIRE(file.stats("scalars").dataset_opens <= scalar_opens + 1);
+  REQUIRE(file.stats("scaled").dataset_opens <= scaled_opens + 1);
+
+  // Automatically sized caches hold several chunks
+  hid_t dataset_id = H5Dopen2(file.file_id(), "scaled", H5P_DEFAULT);
+  hid_t plist_id = hdf5::chunk_cache_plist(dataset_id, ChunkCache(), true);
+  size_t nslots, nbytes;
+  double w0;
+  H5Pget_chunk_cache(plist_id, &nslots, &nbytes, &w0);
+  REQUIRE(nbytes >= LIME_CHUNK_CACHE_MIN_BYTES);
+  REQUIRE(nslots >= 521);
+  REQUIRE(w0 == 1.);
+  H5Pclose(plist_id);
+
+  plist_id = hdf5::chunk_cache_plist(
+      dataset_id, ChunkCache(ChunkCache::RandomRead, 1 << 22), false);
+  H5Pget_chunk_cache(plist_id, &nslots, &nbytes, &w0);
+  REQUIRE(nbytes == 1 << 22);
+  REQUIRE(w0 == 0.75);
+  H5Pclose(plist_id);
+  H5Dclose(dataset_id);
+
+  // User caches reopen the dataset
+  file.set_chunk_cache("scalars", ChunkCache(ChunkCache::Append, 1 << 21));
+  file["scalars"] << 100.0;
+  REQUIRE(file.stats("scalars").dataset_opens <= scalar_opens + 2);
+
+  // Operations on missing fields fail without statistics
+  dvector missing;
+  REQUIRE_THROWS(file.read("missing", missing));
+  REQUIRE(file.stats().count("missing") == 0);
+
+  // More fields than datasets kept open
+  int n_fields = LIME_MAX_OPEN_DATASETS + 10;
+  for (int round = 0; round < 3; ++round)
+    for (int idx = 0; idx < n_fields; ++idx)
+      file["many/" + std::to_string(idx)] << (double)(round + idx);
+  file.close();
+
+  file = FileH5(filename, "r");
+
+  // Completely set caches are used when first opening the dataset
+  ChunkCache cache(ChunkCache::RandomRead, 1 << 22);
+  cache.nslots = 1009;
+  cache.w0 = 0.5;
+  hid_t access_id;
+  dataset_id = hdf5::open_chunked_dataset(file.file_id(), "scaled", cache,
+                                          false, access_id);
+  plist_id = H5Dget_access_plist(dataset_id);
+  H5Pget_chunk_cache(plist_id, &nslots, &nbytes, &w0);
+  REQUIRE(nslots == 1009);
+  REQUIRE(nbytes == 1 << 22);
+  REQUIRE(w0 == 0.5);
+  H5Pclose(plist_id);
+  H5Pclose(access_id);
+  H5Dclose(dataset_id);
+
+  std::vector<double> scalars;
+  file.read("scalars", scalars);
+  REQUIRE(scalars.size() == 101);
+  for (int idx = 0; idx < 101; ++idx)
+    REQUIRE(scalars[idx] == (double)idx);
+  dvector read;
+  for (int idx = 0; idx < 100; idx += 7) {
+    file.read("scaled", idx, read);
+    for (int i = 0; i < 50; ++i)
+      REQUIRE(std::abs(read(i) - vec(i)) <= 1e-3);
+  }
+  for (int idx = 0; idx < n_fields; ++idx) {
+    file.read("many/" + std::to_string(idx), scalars);
+    REQUIRE(scalars == std::vector<double>({(double)idx, (double)(idx + 1),
+                                            (double)(idx + 2)}));
+  }
+
+  // Kept datasets are only shared with helpers working on the same file
+  std::string other_filename = "test_file_other.h5";
+  remove(other_filename.c_str());
+  auto other = FileH5(other_filename, "w");
+  other["scalars"] << 1.0;
+  dataset_id = H5Dopen2(file.file_id(), "scalars", H5P_DEFAULT);
+  {
+    hdf5::FieldScope scope(file.file_id(), "scalars", nullptr, dataset_id);
+    hid_t other_id = hdf5::open_dataset(other.file_id(), "scalars");
+    REQUIRE(other_id != dataset_id);
+    REQUIRE(hdf5::get_dataspace_dims(other_id)[0] == 1);
+    H5Dclose(other_id);
+  }
+  H5Dclose(dataset_id);
+  other.close();
+  remove(other_filename.c_str());
+  file.close();
+
+  remove(filename.c_str());
+}
@@ -0,0 +1,95 @@
+// Copyright 2020 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdio.h>
+#include <vector>
+
+#include "catch.hpp"
+
+#include <lime/all.h>
+
+using namespace lime;
+
+TEST_CASE("file_h5_group", "[file]") {
+  std::string filename = "test_file.h5";
+  std::string repacked = "test_file_repacked.h5";
+  remove(filename.c_str());
+  remove(repacked.c_str());
+
+  // Hierarchical field names create nested groups
+  auto file = FileH5(filename, "w");
+  file["parameters/seed"] = 42;
+  Measurements measurements;
+  for (int idx = 0; idx < 10; ++idx) {
+    measurements["mc/energy"] << (double)idx;
+    measurements["mc/corr/xx"] << lila::Random<double>(4);
+    measurements["mc/corr/zz"] << lila::Random<double>(4);
+    measurements["sweeps"] << idx;
+  }
+  measurements.dump(file);
+  REQUIRE(file.groups() ==
+          std::vector<std::string>{"mc", "mc/corr", "parameters"});
+  REQUIRE(file.fields("mc/corr") ==
+          std::vector<std::string>{"mc/corr/xx", "mc/corr/zz"});
+  REQUIRE(file.fields("mc").size() == 3);
+  REQUIRE(file.fields("").size() == 5);
+  file.close();
+
+  // Measurements are dumped into the group a file is opened on
+  file = FileH5(filename, "a", "qmc/run1");
+  REQUIRE(file.fields().empty());
+  Measurements group_measurements;
+  for (int idx = 0; idx < 5; ++idx)
+    group_measurements["energy"] << (double)idx;
+  group_measurements.dump(file);
+  file.close();
+
+  file = FileH5(filename, "r");
+  REQUIRE(file.defined("qmc/run1/energy"));
+  REQUIRE(file.size("qmc/run1/energy") == 5);
+  REQUIRE(file.fields("mc/corr/xx").empty());
+  file.close();
+
+  // Only the fields of a group are parsed and read
+  file = FileH5(filename, "r", "mc");
+  REQUIRE(file.group() == "mc");
+  REQUIRE(file.fields().size() == 3);
+  REQUIRE(file.defined("corr/xx"));
+  REQUIRE(!file.defined("sweeps"));
+  Measurements read_measurements;
+  read_measurements.read(file);
+  REQUIRE(read_measurements.fields().size() == 3);
+  double energy;
+  read_measurements["energy"].get(7, energy);
+  REQUIRE(energy == 7.0);
+  dvector corr;
+  file.read("corr/zz", 3, corr);
+  dvector corr_expected;
+  measurements.get("mc/corr/zz", 3, corr_expected);
+  REQUIRE(corr == corr_expected);
+  file.close();
+  REQUIRE_THROWS(FileH5(filename, "r", "none"));
+
+  // Groups can be compacted separately
+  RepackOptions options;
+  options.group = "mc/corr";
+  repack(filename, repacked, options);
+  file = FileH5(repacked, "r");
+  REQUIRE(file.fields() ==
+          std::vector<std::string>{"mc/corr/xx", "mc/corr/zz"});
+  file.close();
+
+  remove(filename.c_str());
+  remove(repacked.c_str());
+}
@@ -0,0 +1,153 @@
+// Copyright 2020 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdio.h>
+
+#include "catch.hpp"
+
+#include <lime/all.h>
+
+using namespace lime;
+
+template <class coeff_t> lila::Vector<coeff_t> integer_vector(long n, long seed) {
+  auto vec = lila::Vector<coeff_t>(n);
+  for (long i = 0; i < n; ++i)
+    vec(i) = (coeff_t)((i * 7 + seed * 13) % 101);
+  return vec;
+}
+
+template <class coeff_t>
+lila::Matrix<coeff_t> integer_matrix(long m, long n, long seed) {
+  auto mat = lila::Matrix<coeff_t>(m, n);
+  for (long i = 0; i < m; ++i)
+    for (long j = 0; j < n; ++j)
+      mat(i, j) = (coeff_t)((i * 7 + j * 3 + seed * 13) % 101);
+  return mat;
+}
+
+BoolVector bool_vector(long n, long seed) {
+  auto vec = BoolVector(n);
+  for (long i = 0; i < n; ++i)
+    vec.set(i, ((i * 7 + seed * 13) % 5) < 2);
+  return vec;
+}
+
+template <class data_t> void test_file_h5_integer_rdwr(data_t const &val1) {
+  std::string filename = "test_file.h5";
+  remove(filename.c_str());
+
+  auto file = FileH5(filename, "w");
+  file["static"] = val1;
+  for (int idx = 0; idx < 3; ++idx)
+    file["extensible"] << val1;
+  file.close();
+
+  data_t val2;
+  std::vector<data_t> vals;
+  file = FileH5(filename, "r");
+  REQUIRE(file["static"].type() == type_string(val1));
+  REQUIRE(file["extensible"].type() == type_string(val1));
+  file["static"].read(val2);
+  REQUIRE(lila::equal(val1, val2));
+  file["extensible"].read(vals);
+  REQUIRE(vals.size() == 3);
+  for (auto const &val : vals)
+    REQUIRE(lila::equal(val1, val));
+  file["extensible"].read(2, val2);
+  REQUIRE(lila::equal(val1, val2));
+  file.close();
+  remove(filename.c_str());
+}
+
+TEST_CASE("file_h5_integer", "[file]") {
+  test_file_h5_integer_rdwr(integer_vector<int>(10, 1));
+  test_file_h5_integer_rdwr(integer_vector<unsigned>(10, 2));
+  test_file_h5_integer_rdwr(integer_vector<long>(10, 3));
+  test_file_h5_integer_rdwr(integer_vector<unsigned long>(10, 4));
+  test_file_h5_integer_rdwr(integer_vector<long long>(10, 5));
+  test_file_h5_integer_rdwr(integer_vector<unsigned long long>(10, 6));
+
+  test_file_h5_integer_rdwr(integer_matrix<int>(10, 7, 1));
+  test_file_h5_integer_rdwr(integer_matrix<unsigned>(10, 7, 2));
+  test_file_h5_integer_rdwr(integer_matrix<long>(10, 7, 3));
+  test_file_h5_integer_rdwr(integer_matrix<unsigned long>(10, 7, 4));
+  test_file_h5_integer_rdwr(integer_matrix<long long>(10, 7, 5));
+  test_file_h5_integer_rdwr(integer_matrix<unsigned long long>(10, 7, 6));
+  REQUIRE(type_string(ivector()) == "IntVector");
+  REQUIRE(type_string(ullmatrix()) == "UllongMatrix");
+}
+
+TEST_CASE("file_h5_bool_vector", "[file]") {
+  auto vec = bool_vector(21, 1);
+  REQUIRE(vec.size() == 21);
+  REQUIRE(vec.nbytes() == 3);
+  REQUIRE(type_string(vec) == "BoolVector");
+  vec.resize(13);
+  vec.resize(21);
+  for (long i = 13; i < 21; ++i)
+    REQUIRE(!vec(i));
+  REQUIRE(BoolVector(std::vector<bool>({true, false, true})).count() == 2);
+
+  for (long n : {1, 8, 21, 64}) {
+    test_file_h5_integer_rdwr(bool_vector(n, 1));
+    test_file_h5_integer_rdwr(bool_vector(n, 2));
+  }
+
+  // Entries of a field need to have the same number of values
+  std::string filename = "test_file.h5";
+  remove(filename.c_str());
+  auto file = FileH5(filename, "w");
+  file["bools"] << bool_vector(21, 1);
+  REQUIRE(file["bools"].attribute(LIME_FIELD_BIT_COUNT_STRING) == "21");
+  REQUIRE_THROWS(file["bools"] << bool_vector(20, 1));
+  REQUIRE_THROWS(file["bools"] << bool_vector(24, 1));
+  file.close();
+  remove(filename.c_str());
+}
+
+TEST_CASE("measurements_integer", "[measurements]") {
+  std::string filename = "test_file.h5";
+  std::string logname = "test_file.h5.log";
+  remove(filename.c_str());
+  remove(logname.c_str());
+
+  auto file = FileH5(filename, "w");
+  auto m1 = Measurements();
+  m1.checkpoint(logname, 4);
+  for (int idx = 0; idx < 10; ++idx) {
+    m1["ivector"] << integer_vector<int>(5, idx);
+    m1["ulmatrix"] << integer_matrix<unsigned long>(3, 2, idx);
+    m1["bools"] << bool_vector(11, idx);
+    m1.dump(file);
+  }
+
+  // Entries are recovered from the file and the checkpoint log
+  auto m2 = Measurements();
+  m2.checkpoint(logname, 4);
+  m2.read(file);
+  file.close();
+  for (int idx = 0; idx < 10; ++idx) {
+    ivector ivec;
+    ulmatrix ulmat;
+    BoolVector bools;
+    m2["ivector"].get(idx, ivec);
+    m2["ulmatrix"].get(idx, ulmat);
+    m2["bools"].get(idx, bools);
+    REQUIRE(lila::equal(ivec, integer_vector<int>(5, idx)));
+    REQUIRE(lila::equal(ulmat, integer_matrix<unsigned long>(3, 2, idx)));
+    REQUIRE(bools == bool_vector(11, idx));
+  }
+  remove(filename.c_str());
+  remove(logname.c_str());
+}
@@ -0,0 +1,69 @@
+// Copyright 2018 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <complex>
+#include <stdio.h>
+
+#include "catch.hpp"
+
+#include <lime/all.h>
+
+template <class data_t> void test_file_h5_map_vector() {
+  std::string filename = "test_file.h5";
+  remove(filename.c_str());
+
+  auto vec = lila::Random<data_t>(100);
+  auto file = lime::FileH5(filename, "w");
+  file["static"] = vec;
+  file["extensible"] << vec;
+  file["extensible"] << vec;
+
+  // Static fields are stored contiguously and get mapped
+  auto mapped = file.map<data_t>("static");
+  REQUIRE(mapped.mapped());
+  REQUIRE(mapped.size() == 100);
+  REQUIRE(mapped.shape().size() == 1);
+  for (int idx = 0; idx < 100; ++idx)
+    REQUIRE(mapped[idx] == vec(idx));
+  file.close();
+
+  // Mapping stays valid after the file is closed
+  for (int idx = 0; idx < 100; ++idx)
+    REQUIRE(mapped[idx] == vec(idx));
+
+  // Chunked fields are read into a buffer
+  file = lime::FileH5(filename, "r");
+  auto buffered = file.map<data_t>("extensible");
+  REQUIRE(!buffered.mapped());
+  REQUIRE(buffered.size() == 200);
+  REQUIRE(buffered.shape()[0] == 2);
+  REQUIRE(buffered.shape()[1] == 100);
+  for (int idx = 0; idx < 100; ++idx) {
+    REQUIRE(buffered[idx] == vec(idx));
+    REQUIRE(buffered[100 + idx] == vec(idx));
+  }
+
+  // Mapping with a wrong entry type throws
+  REQUIRE_THROWS(file.map<int>("static"));
+  file.close();
+  remove(filename.c_str());
+}
+
+TEST_CASE("file_h5_map", "[file]") {
+  test_file_h5_map_vector<float>();
+  test_file_h5_map_vector<double>();
+  test_file_h5_map_vector<std::complex<float>>();
+  test_file_h5_map_vector<std::complex<double>>();
+}
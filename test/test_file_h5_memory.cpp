@@ -0,0 +1,96 @@
+// Copyright 2020 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdio.h>
+#include <vector>
+
+#include "catch.hpp"
+
+#include <lime/all.h>
+
+using namespace lime;
+
+TEST_CASE("file_h5_memory", "[file]") {
+  std::string filename = "test_file.h5";
+  remove(filename.c_str());
+
+  auto vec = lila::Random<double>(10);
+  auto mat = lila::Random<double>(3, 4);
+
+  // Scratch files never touch the disk
+  FileH5Options options;
+  options.in_memory = true;
+  options.backing_store = false;
+  auto file = FileH5(filename, "w", options);
+  for (int idx = 0; idx < 100; ++idx)
+    file["scalars"] << (double)idx;
+  file["matrix"] = mat;
+  file["group/vectors"] << vec;
+  auto image = file.image();
+  REQUIRE(image.size() > 0);
+
+  // In-memory fields are read to a buffer when mapped
+  auto mapped = file.map<double>("matrix");
+  REQUIRE(mapped.size() == 12);
+  file.close();
+  REQUIRE(!exists(filename));
+
+  // Images of files can be opened again in memory
+  file = FileH5::from_image(image);
+  std::vector<double> scalars;
+  file.read("scalars", scalars);
+  REQUIRE(scalars.size() == 100);
+  REQUIRE(scalars[42] == 42.);
+  dmatrix read_mat;
+  file.read("matrix", read_mat);
+  REQUIRE(read_mat == mat);
+  REQUIRE_THROWS(file["scalars"] << 100.);
+  auto other = FileH5::from_image(image, "a", "group");
+  other["vectors"] << vec;
+  REQUIRE(other.size("vectors") == 2);
+  REQUIRE(file.size("scalars") == 100);
+
+  // Images of files opened on a group hold the whole file
+  auto group_image = other.image();
+  other.close();
+  other = FileH5::from_image(group_image, "r", "group");
+  REQUIRE(other.size("vectors") == 2);
+  other.close();
+  other = FileH5::from_image(group_image);
+  REQUIRE(other.size("scalars") == 100);
+  REQUIRE(other.size("group/vectors") == 2);
+  other.close();
+  file.close();
+  REQUIRE_THROWS(FileH5::from_image(image, "w"));
+  REQUIRE_THROWS(FileH5::from_image(std::vector<char>(100, 'x')));
+
+  // With a backing store the file is written on close
+  options.backing_store = true;
+  file = FileH5(filename, "w", options);
+  for (int idx = 0; idx < 100; ++idx)
+    file["scalars"] << (double)idx;
+  file.close();
+  file = FileH5(filename, "a", options);
+  file["scalars"] << 100.;
+  file.close();
+
+  file = FileH5(filename, "r");
+  file.read("scalars", scalars);
+  REQUIRE(scalars.size() == 101);
+  REQUIRE(scalars[100] == 100.);
+  REQUIRE(file.image().size() > 0);
+  file.close();
+
+  remove(filename.c_str());
+}
@@ -0,0 +1,95 @@
+// Copyright 2020 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdio.h>
+#include <vector>
+
+#include "catch.hpp"
+
+#include <lime/all.h>
+
+using namespace lime;
+
+TEST_CASE("file_h5_options", "[file]") {
+  std::string filename = "test_file.h5";
+  remove(filename.c_str());
+
+  FileH5Options options;
+  options.latest_format = true;
+  options.alignment = 4096;
+  options.alignment_threshold = 1024;
+  options.paged_aggregation = true;
+  options.page_size = 8192;
+  options.meta_block_size = 8192;
+  options.metadata_cache_bytes = 4 << 20;
+
+  auto vec = lila::Random<double>(1000);
+  auto file = FileH5(filename, "w", options);
+  file["vector"] = vec;
+  for (int idx = 0; idx < 10; ++idx)
+    file["vectors"] << vec;
+
+  hid_t access_id = H5Fget_access_plist(file.file_id());
+  H5F_libver_t low, high;
+  H5Pget_libver_bounds(access_id, &low, &high);
+  REQUIRE(low == H5F_LIBVER_LATEST);
+  hsize_t threshold, alignment;
+  H5Pget_alignment(access_id, &threshold, &alignment);
+  REQUIRE(alignment == 4096);
+  REQUIRE(threshold == 1024);
+  H5Pclose(access_id);
+
+  hid_t create_id = H5Fget_create_plist(file.file_id());
+  H5F_fspace_strategy_t strategy;
+  hbool_t persist;
+  hsize_t page_size;
+  H5Pget_file_space_strategy(create_id, &strategy, &persist, &threshold);
+  H5Pget_file_space_page_size(create_id, &page_size);
+  REQUIRE(strategy == H5F_FSPACE_STRATEGY_PAGE);
+  REQUIRE(page_size == 8192);
+  H5Pclose(create_id);
+
+  H5AC_cache_config_t config;
+  config.version = H5AC__CURR_CACHE_CONFIG_VERSION;
+  H5Fget_mdc_config(file.file_id(), &config);
+  REQUIRE(config.max_size >= (size_t)(4 << 20));
+
+  // Large contiguous fields start at aligned addresses
+  haddr_t offset;
+  hid_t dataset_id = H5Dopen2(file.file_id(), "vector", H5P_DEFAULT);
+  REQUIRE(hdf5::get_contiguous_offset(dataset_id, offset));
+  REQUIRE(offset % 4096 == 0);
+  H5Dclose(dataset_id);
+  file.close();
+
+  // Paged files can be read through a page buffer
+  FileH5Options read_options;
+  read_options.page_buffer_bytes = 1 << 20;
+  file = FileH5(filename, "r", read_options);
+  REQUIRE(file.options().page_buffer_bytes == 1 << 20);
+  dvector read;
+  file.read("vector", read);
+  REQUIRE(read == vec);
+  file.read("vectors", 9, read);
+  REQUIRE(read == vec);
+  file.close();
+
+  // Options hdf5 can't use are reported
+  FileH5Options invalid;
+  invalid.paged_aggregation = true;
+  invalid.page_size = 1;
+  REQUIRE_THROWS(FileH5(filename, "w!", invalid));
+
+  remove(filename.c_str());
+}
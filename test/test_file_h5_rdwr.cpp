@@ -66,7 +66,7 @@ template <class data_t> void test_file_h5_rdwr_matrix() {
   std::string filename = "test_file.h5";
   remove(filename.c_str());
 
-  auto mat1 = lila::Random<data_t>(10, 10);
+  auto mat1 = lila::Random<data_t>(10, 7);
   auto file = lime::FileH5(filename, "w");
   file["test"] = mat1;
   file.close();
@@ -106,3 +106,53 @@ TEST_CASE("file_h5_rdwr", "[file]") {
   test_file_h5_rdwr_matrix<std::complex<float>>();
   test_file_h5_rdwr_matrix<std::complex<double>>();
 }
+
+TEST_CASE("file_h5_layout", "[file]") {
+  std::string filename = "test_file.h5";
+  remove(filename.c_str());
+
+  // Matrices are stored column-major with transposed dimensions
+  auto mat1 = lila::Random<double>(5, 3);
+  auto file = lime::FileH5(filename, "w");
+  file["static"] = mat1;
+  file["extensible"] << mat1;
+  REQUIRE(file["static"].attribute(LIME_FIELD_LAYOUT_STRING) ==
+          "ColumnMajor");
+  REQUIRE(file["extensible"].attribute(LIME_FIELD_LAYOUT_STRING) ==
+          "ColumnMajor");
+  hid_t dataset_id = H5Dopen2(file.file_id(), "static", H5P_DEFAULT);
+  REQUIRE(lime::hdf5::get_dataspace_dims(dataset_id) ==
+          std::vector<hsize_t>({3, 5}));
+  H5Dclose(dataset_id);
+  file.close();
+
+  // Matrices written row-major by older versions are still readable
+  remove(filename.c_str());
+  hid_t file_id =
+      H5Fcreate(filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+  hsize_t dims[2] = {5, 3};
+  hid_t dataspace_id = H5Screate_simple(2, dims, NULL);
+  dataset_id = H5Dcreate2(file_id, "legacy", H5T_NATIVE_DOUBLE, dataspace_id,
+                          H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  auto mat1_T = lila::Transpose(mat1);
+  H5Dwrite(dataset_id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT,
+           mat1_T.data());
+  lime::hdf5::set_attribute_value(dataset_id, LIME_FIELD_TYPE_STRING,
+                                  "DoubleMatrix");
+  lime::hdf5::set_attribute_value(
+      dataset_id, LIME_FIELD_STATIC_EXTENSIBLE_STRING, "Static");
+  H5Dclose(dataset_id);
+  H5Sclose(dataspace_id);
+  H5Fclose(file_id);
+
+  auto mat2 = lila::Matrix<double>();
+  file = lime::FileH5(filename, "a");
+  file["legacy"].read(mat2);
+  REQUIRE(lila::equal(mat1, mat2));
+  auto mat3 = lila::Random<double>(5, 3);
+  file.write("legacy", mat3, true);
+  file["legacy"].read(mat2);
+  REQUIRE(lila::equal(mat3, mat2));
+  file.close();
+  remove(filename.c_str());
+}
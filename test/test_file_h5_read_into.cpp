@@ -0,0 +1,71 @@
+// Copyright 2020 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdio.h>
+#include <vector>
+
+#include "catch.hpp"
+
+#include <lime/all.h>
+
+using namespace lime;
+
+TEST_CASE("file_h5_read_into", "[file]") {
+  std::string filename = "test_file.h5";
+  remove(filename.c_str());
+
+  auto vec = lila::Random<double>(10);
+  auto file = FileH5(filename, "w");
+  file["vector"] = vec;
+  for (int idx = 0; idx < 5; ++idx) {
+    file["scalars"] << (double)idx;
+    file["matrices"] << lila::Random<double>(3, 4);
+  }
+  file.close();
+
+  file = FileH5(filename, "r");
+  std::vector<double> buffer(12);
+  file["vector"].read_into(buffer.data(), 10);
+  for (int i = 0; i < 10; ++i)
+    REQUIRE(buffer[i] == vec(i));
+  file.read_into("scalars", buffer.data(), 5);
+  for (int i = 0; i < 5; ++i)
+    REQUIRE(buffer[i] == (double)i);
+
+  // Matrices are read column-major in storage order
+  std::vector<dmatrix> mats;
+  file["matrices"].read(mats);
+  std::vector<double> all(60);
+  file.read_into("matrices", all.data(), 60);
+  file.read_into("matrices", 3, buffer.data(), 12);
+  for (int i = 0; i < 3; ++i)
+    for (int j = 0; j < 4; ++j) {
+      REQUIRE(all[36 + j * 3 + i] == mats[3](i, j));
+      REQUIRE(buffer[j * 3 + i] == mats[3](i, j));
+    }
+
+  // Shape, type and index are validated
+  REQUIRE_THROWS(file.read_into("vector", buffer.data(), 9));
+  REQUIRE_THROWS(file.read_into("matrices", 5, buffer.data(), 12));
+  REQUIRE_THROWS(file.read_into("vector", 0, buffer.data(), 10));
+  std::vector<int> ints(10);
+  REQUIRE_THROWS(file.read_into("vector", ints.data(), 10));
+
+  // Repeated reads reuse the memory of the entries
+  const double *data = mats[2].data();
+  file["matrices"].read(mats);
+  REQUIRE(mats[2].data() == data);
+  file.close();
+  remove(filename.c_str());
+}
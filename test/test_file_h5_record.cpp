@@ -0,0 +1,168 @@
+// Copyright 2020 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdio.h>
+#include <vector>
+
+#include "catch.hpp"
+
+#include <lime/all.h>
+
+using namespace lime;
+
+TEST_CASE("file_h5_record", "[file]") {
+  std::string filename = "test_file.h5";
+  remove(filename.c_str());
+
+  SECTION("members") {
+    Record record;
+    record.set("energy", 1.5);
+    record.set("sweeps", (long)3);
+    record.set("energy", 2.5);
+    REQUIRE(record.members() == std::vector<std::string>{"energy", "sweeps"});
+    REQUIRE(record.type("sweeps") == "Long");
+    REQUIRE(record.get<double>("energy") == 2.5);
+    REQUIRE(record.nbytes() == sizeof(double) + sizeof(long));
+    REQUIRE_THROWS(record.set("sweeps", 1.0));
+    REQUIRE_THROWS(record.get<double>("sweeps"));
+    REQUIRE_THROWS(record.get<double>("magnetization"));
+  }
+
+  SECTION("write/append/read") {
+    std::vector<Record> records;
+    for (int idx = 0; idx < 20; ++idx) {
+      Record record;
+      record.set("energy", (double)idx);
+      record.set("magnetization", (float)(2 * idx));
+      record.set("sign", zscalar(idx, -idx));
+      record.set("step", idx);
+      records.push_back(record);
+    }
+
+    auto file = FileH5(filename, "w");
+    file["static"] = records[3];
+    for (int idx = 0; idx < 5; ++idx)
+      file["observables"] << records[idx];
+    file.append("observables", records.data() + 5, 15);
+    REQUIRE(file.type("observables") == "Record");
+    REQUIRE(file.size("observables") == 20);
+
+    // Members of appended records need to agree with the field
+    Record other;
+    other.set("energy", 1.0);
+    REQUIRE_THROWS(file.append("observables", other));
+    REQUIRE_THROWS(file.append("static", records[0]));
+    file.close();
+
+    file = FileH5(filename, "r");
+    Record record;
+    file["static"].read(record);
+    REQUIRE(record == records[3]);
+    file["observables"].read(7, record);
+    REQUIRE(record == records[7]);
+
+    std::vector<Record> read_records;
+    file["observables"].read(read_records);
+    REQUIRE(read_records == records);
+
+    // Single members are read from all entries
+    std::vector<double> energies;
+    std::vector<zscalar> signs;
+    file["observables"].read_member("energy", energies);
+    file.read_member("observables", "sign", signs);
+    REQUIRE(energies.size() == 20);
+    for (int idx = 0; idx < 20; ++idx) {
+      REQUIRE(energies[idx] == (double)idx);
+      REQUIRE(signs[idx] == zscalar(idx, -idx));
+    }
+    REQUIRE_THROWS(file.read_member("observables", "step", energies));
+    REQUIRE_THROWS(file.read_member("observables", "none", energies));
+    file.close();
+  }
+
+  SECTION("integer members") {
+    // Integer types of equal size keep their type when read back
+    Record record;
+    record.set("int", (int)-1);
+    record.set("unsigned", (unsigned)1);
+    record.set("long", (long)-2);
+    record.set("ulong", (unsigned long)2);
+    record.set("seed", (long long)-3);
+    record.set("count", (unsigned long long)3);
+
+    auto file = FileH5(filename, "w");
+    file["static"] = record;
+    file["observables"] << record;
+    file.close();
+
+    file = FileH5(filename, "r");
+    Record read_record;
+    file["static"].read(read_record);
+    REQUIRE(read_record == record);
+    REQUIRE(read_record.type("seed") == record.type("seed"));
+    REQUIRE(read_record.type("long") == record.type("long"));
+    REQUIRE(read_record.get<long long>("seed") == -3);
+    REQUIRE(read_record.get<unsigned long long>("count") == 3);
+    REQUIRE(read_record.get<long>("long") == -2);
+    REQUIRE(read_record.get<unsigned long>("ulong") == 2);
+    file["observables"].read(0, read_record);
+    REQUIRE(read_record == record);
+    file.close();
+
+    // Records only present in the checkpoint log are replayed alike
+    std::string logname = filename + ".log";
+    remove(logname.c_str());
+    file = FileH5(filename, "w!");
+    Measurements measurements;
+    measurements.checkpoint(logname, 10);
+    measurements["observables"] << record;
+    measurements.dump(file);
+    file.close();
+
+    file = FileH5(filename, "r");
+    Measurements replayed;
+    replayed.checkpoint(logname, 10);
+    replayed.read(file);
+    replayed["observables"].get(0, read_record);
+    REQUIRE(read_record == record);
+    REQUIRE(read_record.get<long long>("seed") == -3);
+    file.close();
+    remove(logname.c_str());
+  }
+
+  SECTION("measurements") {
+    auto file = FileH5(filename, "w");
+    Measurements measurements;
+    for (int idx = 0; idx < 10; ++idx) {
+      Record record;
+      record.set("energy", (double)idx);
+      record.set("step", (long)idx);
+      measurements["observables"] << record;
+      if (idx % 4 == 3)
+        measurements.dump(file);
+    }
+    measurements.dump(file);
+    file.close();
+
+    file = FileH5(filename, "r");
+    std::vector<long> steps;
+    file["observables"].read_member("step", steps);
+    REQUIRE(steps.size() == 10);
+    for (long idx = 0; idx < 10; ++idx)
+      REQUIRE(steps[idx] == idx);
+    file.close();
+  }
+
+  remove(filename.c_str());
+}
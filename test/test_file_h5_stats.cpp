@@ -0,0 +1,81 @@
+// Copyright 2020 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdio.h>
+#include <vector>
+
+#include "catch.hpp"
+
+#include <lime/all.h>
+
+using namespace lime;
+
+TEST_CASE("file_h5_stats", "[file]") {
+  std::string filename = "test_file.h5";
+  remove(filename.c_str());
+
+  auto file = FileH5(filename, "w");
+  file["untracked"] << 1.0;
+  REQUIRE(file.stats().empty());
+
+  file.collect_stats();
+  for (int idx = 0; idx < 10; ++idx)
+    file["scalars"] << (double)idx;
+  std::vector<dvector> vectors(5, lila::Random<double>(4));
+  file.append("vectors", vectors);
+  file["static"] = lila::Random<double>(3, 2);
+
+  auto stats = file.stats("scalars");
+  REQUIRE(stats.appends == 10);
+  REQUIRE(stats.entries_appended == 10);
+  REQUIRE(stats.bytes_written == 10 * (long)sizeof(double));
+  REQUIRE(stats.extent_changes == 10);
+  REQUIRE(stats.dataset_opens > 0);
+  REQUIRE(stats.seconds.count("append_extensible_field") == 1);
+  REQUIRE(stats.seconds.count("create_extensible_field") == 1);
+
+  // Bulk appends change the extent only once
+  stats = file.stats("vectors");
+  REQUIRE(stats.appends == 1);
+  REQUIRE(stats.entries_appended == 5);
+  REQUIRE(stats.bytes_written == 20 * (long)sizeof(double));
+  REQUIRE(stats.extent_changes == 1);
+
+  stats = file.stats("static");
+  REQUIRE(stats.writes == 1);
+  REQUIRE(stats.bytes_written == 6 * (long)sizeof(double));
+
+  std::vector<double> scalars;
+  file.read("scalars", scalars);
+  dvector vec;
+  file.read("vectors", 2, vec);
+  REQUIRE(file.stats("scalars").reads == 1);
+  REQUIRE(file.stats("scalars").bytes_read == 10 * (long)sizeof(double));
+  REQUIRE(file.stats("vectors").bytes_read == 4 * (long)sizeof(double));
+  REQUIRE(file.stats().count("untracked") == 0);
+
+  // Statistics are stored as attributes, repeatedly
+  file.write_stats();
+  file["scalars"] << 10.0;
+  file.write_stats();
+  REQUIRE(file["scalars"].attribute(LIME_FIELD_STATS_STRING) ==
+          stats_string(file.stats("scalars")));
+
+  file.collect_stats(false);
+  file["scalars"] << 11.0;
+  REQUIRE(file.stats("scalars").appends == 11);
+  file.close();
+
+  remove(filename.c_str());
+}
@@ -0,0 +1,96 @@
+// Copyright 2020 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cmath>
+#include <complex>
+#include <stdio.h>
+
+#include "catch.hpp"
+
+#include <lime/all.h>
+
+using namespace lime;
+
+static size_t stored_size(FileH5 const &file, std::string field) {
+  hid_t dataset_id = H5Dopen2(file.file_id(), field.c_str(), H5P_DEFAULT);
+  hid_t datatype_id = H5Dget_type(dataset_id);
+  size_t size = H5Tget_size(datatype_id);
+  H5Tclose(datatype_id);
+  H5Dclose(dataset_id);
+  return size;
+}
+
+TEST_CASE("file_h5_storage", "[file]") {
+  std::string filename = "test_file.h5";
+  remove(filename.c_str());
+
+  auto vec = lila::Random<double>(20);
+  auto mat = lila::Random<std::complex<double>>(4, 3);
+  auto file = FileH5(filename, "w");
+  file["float32"].set_storage(FieldStorage::Float32);
+  file["float16"].set_storage(FieldStorage::Float16);
+  file["scaled"].set_storage(FieldStorage(FieldStorage::Native, 3));
+  file["float32"] = vec;
+  for (int idx = 0; idx < 5; ++idx) {
+    file["float16"] << mat;
+    file["scaled"] << vec;
+  }
+
+  // Fields can only be stored with reduced precision if possible
+  file["int"].set_storage(FieldStorage::Float32);
+  REQUIRE_THROWS(file["int"] << 42);
+  file["complex_scaled"].set_storage(FieldStorage(FieldStorage::Native, 3));
+  REQUIRE_THROWS(file["complex_scaled"] << mat);
+  REQUIRE_THROWS(file["float32"].set_storage(FieldStorage::Float16));
+  file.close();
+
+  file = FileH5(filename, "r");
+  REQUIRE(file["float32"].type() == "DoubleVector");
+  REQUIRE(file["float32"].attribute(LIME_FIELD_STORAGE_TYPE_STRING) ==
+          "Float32");
+  REQUIRE(file["float16"].type() == "ComplexDoubleMatrix");
+  REQUIRE(file["float16"].attribute(LIME_FIELD_STORAGE_TYPE_STRING) ==
+          "Float16");
+  REQUIRE(!file["scaled"].has_attribute(LIME_FIELD_STORAGE_TYPE_STRING));
+  REQUIRE(stored_size(file, "float32") == 4);
+  REQUIRE(stored_size(file, "float16") == 4);
+
+  dvector vec2;
+  file["float32"].read(vec2);
+  for (long i = 0; i < vec.size(); ++i)
+    REQUIRE(vec2(i) == (double)(float)vec(i));
+
+  // Fields with reduced precision are mapped by converting to a buffer
+  auto mapped = file.map<double>("float32");
+  REQUIRE(!mapped.mapped());
+  REQUIRE(mapped.size() == 20);
+  for (long i = 0; i < vec.size(); ++i)
+    REQUIRE(mapped[i] == (double)(float)vec(i));
+  REQUIRE_THROWS(file.map<int>("float32"));
+
+  std::vector<zmatrix> mats;
+  file["float16"].read(mats);
+  REQUIRE(mats.size() == 5);
+  for (long i = 0; i < 4; ++i)
+    for (long j = 0; j < 3; ++j)
+      REQUIRE(std::abs(mats[4](i, j) - mat(i, j)) < 1e-3);
+
+  std::vector<dvector> vecs;
+  file["scaled"].read(vecs);
+  REQUIRE(vecs.size() == 5);
+  for (long i = 0; i < vec.size(); ++i)
+    REQUIRE(std::abs(vecs[2](i) - vec(i)) <= 1e-3);
+  file.close();
+  remove(filename.c_str());
+}
@@ -0,0 +1,118 @@
+// Copyright 2020 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <complex>
+#include <stdio.h>
+
+#include "catch.hpp"
+
+#include <lime/all.h>
+
+using namespace lime;
+
+template <class coeff_t>
+Tensor<coeff_t> test_tensor(std::vector<int64_t> const &shape, long seed) {
+  auto tensor = Tensor<coeff_t>(shape);
+  for (long i = 0; i < tensor.size(); ++i)
+    tensor.data()[i] = (coeff_t)((i * 7 + seed * 13) % 101);
+  return tensor;
+}
+
+template <class coeff_t> void test_file_h5_tensor_rdwr() {
+  std::string filename = "test_file.h5";
+  remove(filename.c_str());
+
+  auto tensor1 = test_tensor<coeff_t>({4, 3, 5}, 1);
+  auto file = FileH5(filename, "w");
+  file["static"] = tensor1;
+  for (int idx = 0; idx < 4; ++idx)
+    file["extensible"] << test_tensor<coeff_t>({4, 3, 5}, idx);
+
+  // Entries of another shape can't be appended
+  REQUIRE_THROWS(file["extensible"] << test_tensor<coeff_t>({4, 5, 3}, 0));
+  REQUIRE_THROWS(file["extensible"] << test_tensor<coeff_t>({4, 3}, 0));
+  file.close();
+
+  file = FileH5(filename, "r");
+  REQUIRE(file["static"].type() == type_string(tensor1));
+  REQUIRE(file["extensible"].size() == 4);
+  Tensor<coeff_t> tensor2;
+  file["static"].read(tensor2);
+  REQUIRE(tensor1 == tensor2);
+  std::vector<Tensor<coeff_t>> tensors;
+  file["extensible"].read(tensors);
+  REQUIRE(tensors.size() == 4);
+  for (int idx = 0; idx < 4; ++idx)
+    REQUIRE(tensors[idx] == test_tensor<coeff_t>({4, 3, 5}, idx));
+  file["extensible"].read(2, tensor2);
+  REQUIRE(tensor2 == test_tensor<coeff_t>({4, 3, 5}, 2));
+  file.close();
+  remove(filename.c_str());
+}
+
+TEST_CASE("file_h5_tensor", "[file]") {
+  test_file_h5_tensor_rdwr<int>();
+  test_file_h5_tensor_rdwr<unsigned long long>();
+  test_file_h5_tensor_rdwr<float>();
+  test_file_h5_tensor_rdwr<double>();
+  test_file_h5_tensor_rdwr<std::complex<float>>();
+  test_file_h5_tensor_rdwr<std::complex<double>>();
+
+  auto tensor = test_tensor<double>({2, 3, 4, 5}, 0);
+  REQUIRE(tensor.rank() == 4);
+  REQUIRE(tensor.size() == 120);
+  REQUIRE(tensor(1, 2, 3, 4) == tensor.data()[119]);
+  REQUIRE(tensor(1, 0, 2, 1) == tensor.data()[60 + 10 + 1]);
+  REQUIRE(type_string(tensor) == "DoubleTensor");
+}
+
+TEST_CASE("file_h5_bulk_append_hyperslab", "[file]") {
+  std::string filename = "test_file.h5";
+  remove(filename.c_str());
+
+  // Bulk append of several entries with a single write
+  std::vector<dtensor> tensors;
+  for (int idx = 0; idx < 6; ++idx)
+    tensors.push_back(test_tensor<double>({3, 4, 2}, idx));
+  auto file = FileH5(filename, "w");
+  file.append("tensor", tensors);
+  file.append("tensor", tensors.data() + 2, 3);
+  REQUIRE(file.size("tensor") == 9);
+  std::vector<dvector> vectors = {lila::Random<double>(4),
+                                  lila::Random<double>(5)};
+  REQUIRE_THROWS(file.append("vector", vectors));
+  std::vector<double> scalars = {1.0, 2.0, 3.0};
+  file["scalar"] << scalars;
+  REQUIRE(file.size("scalar") == 3);
+
+  // Read a single slice of all entries
+  dtensor block;
+  file.read_hyperslab("tensor", {0, 1, 0, 0}, {9, 1, 4, 2}, block);
+  REQUIRE(block.shape() == std::vector<int64_t>({9, 1, 4, 2}));
+  for (int idx = 0; idx < 9; ++idx) {
+    auto const &entry = (idx < 6) ? tensors[idx] : tensors[idx - 4];
+    for (int j = 0; j < 4; ++j)
+      for (int k = 0; k < 2; ++k)
+        REQUIRE(block(idx, 0, j, k) == entry(1, j, k));
+  }
+  file.read_hyperslab("tensor", {8, 2, 3, 1}, {1, 1, 1, 1}, block);
+  REQUIRE(block.data()[0] == tensors[4](2, 3, 1));
+  REQUIRE_THROWS(
+      file.read_hyperslab("tensor", {8, 2, 3, 1}, {2, 1, 1, 1}, block));
+  stensor wrong;
+  REQUIRE_THROWS(
+      file.read_hyperslab("tensor", {0, 0, 0, 0}, {1, 1, 1, 1}, wrong));
+  file.close();
+  remove(filename.c_str());
+}
@@ -0,0 +1,88 @@
+// Copyright 2020 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdio.h>
+#include <vector>
+
+#include "catch.hpp"
+
+#include <lime/all.h>
+
+using namespace lime;
+
+TEST_CASE("file_h5_view", "[file]") {
+  std::string filename = "test_file.h5";
+  remove(filename.c_str());
+
+  std::vector<double> buffer(24);
+  for (int i = 0; i < 24; ++i)
+    buffer[i] = 0.5 * i;
+
+  // Views are written as their owning types directly from caller memory
+  auto file = FileH5(filename, "w");
+  file["vector"] = view(buffer.data(), 24);
+  file["matrix"] = view(buffer.data(), 6, 4);
+  file["tensor"] = view(buffer.data(), {2, 3, 4});
+  file["std_vector"] = VectorView<double>(buffer);
+  for (int idx = 0; idx < 3; ++idx) {
+    file["vectors"] << view(buffer.data() + idx, 10);
+    file["matrices"] << view(buffer.data() + idx, 3, 2);
+  }
+  REQUIRE(file["vector"].type() == "DoubleVector");
+  REQUIRE(file["matrix"].type() == "DoubleMatrix");
+  REQUIRE(file["tensor"].type() == "DoubleTensor");
+  REQUIRE_THROWS(file["vectors"] << view(buffer.data(), 11));
+  file.close();
+
+  file = FileH5(filename, "r");
+  dvector vec;
+  dmatrix mat;
+  dtensor tensor;
+  file["vector"].read(vec);
+  file["matrix"].read(mat);
+  file["tensor"].read(tensor);
+  REQUIRE(vec.size() == 24);
+  REQUIRE(mat.nrows() == 6);
+  REQUIRE(mat.ncols() == 4);
+  REQUIRE(tensor.shape() == std::vector<int64_t>({2, 3, 4}));
+  for (int i = 0; i < 24; ++i) {
+    REQUIRE(vec(i) == buffer[i]);
+    REQUIRE(mat(i % 6, i / 6) == buffer[i]);
+    REQUIRE(tensor.data()[i] == buffer[i]);
+  }
+  std::vector<dmatrix> mats;
+  file["matrices"].read(mats);
+  REQUIRE(mats.size() == 3);
+  REQUIRE(mats[2](1, 1) == buffer[2 + 4]);
+  file.close();
+
+  // Measurements collect copies of views
+  remove(filename.c_str());
+  file = FileH5(filename, "w");
+  auto measurements = Measurements();
+  measurements["vector"] << view(buffer.data(), 5);
+  buffer[0] = -1.0;
+  measurements["vector"] << view(buffer.data(), 5);
+  measurements.dump(file);
+  file.close();
+
+  file = FileH5(filename, "r");
+  std::vector<dvector> vecs;
+  file["vector"].read(vecs);
+  REQUIRE(vecs.size() == 2);
+  REQUIRE(vecs[0](0) == 0.0);
+  REQUIRE(vecs[1](0) == -1.0);
+  file.close();
+  remove(filename.c_str());
+}
@@ -132,3 +132,94 @@ TEST_CASE("measurements", "[measurements]") {
 
   remove(filename.c_str());
 }
+
+TEST_CASE("measurements_resume", "[measurements]") {
+
+  std::string filename = "test_file.h5";
+  remove(filename.c_str());
+  auto file = lime::FileH5(filename, "w");
+  auto m1 = lime::Measurements();
+  for (int idx = 0; idx < 10; ++idx) {
+    m1["int"] << (int)idx;
+    m1["dscalar"] << (dscalar)idx;
+    m1["zscalar"] << (zscalar)idx;
+    m1["dvector"] << lila::Random<dscalar>(5);
+    m1["zmatrix"] << lila::Random<zscalar>(5, 4);
+    if (idx % 3 == 0)
+      m1.dump(file);
+  }
+  m1.dump(file);
+  file.close();
+
+  // Resume from file, old entries are read on demand
+  file = lime::FileH5(filename, "a");
+  auto m2 = lime::Measurements();
+  m2.resume(file);
+  REQUIRE(m2["int"].previous_dump() == 10);
+  REQUIRE(m2["int"].size() == 10);
+  check_field_agrees<int>(m1, m2, "int");
+  check_field_agrees<zmatrix>(m1, m2, "zmatrix");
+
+  for (int idx = 0; idx < 10; ++idx) {
+    m2["int"] << (int)idx;
+    m2["dscalar"] << (dscalar)idx;
+    m2["zscalar"] << (zscalar)idx;
+    m2["dvector"] << lila::Random<dscalar>(5);
+    m2["zmatrix"] << lila::Random<zscalar>(5, 4);
+    if (idx % 3 == 0)
+      m2.dump(file);
+  }
+  m2.dump(file);
+  REQUIRE(m2["int"].size() == 20);
+  REQUIRE(m2["int"].previous_dump() == 20);
+
+  // Copies read resumed entries after the file has been moved and closed
+  auto m4 = m2;
+  {
+    auto moved = std::move(file);
+    moved.close();
+  }
+  check_field_agrees<int>(m2, m4, "int");
+  check_field_agrees<zmatrix>(m2, m4, "zmatrix");
+  file = lime::FileH5(filename, "a");
+
+  // Read in measurements from file and check if same value
+  auto m3 = lime::Measurements();
+  m3.read(file);
+  check_field_agrees<int>(m2, m3, "int");
+  check_field_agrees<dscalar>(m2, m3, "dscalar");
+  check_field_agrees<zscalar>(m2, m3, "zscalar");
+  check_field_agrees<dvector>(m2, m3, "dvector");
+  check_field_agrees<zmatrix>(m2, m3, "zmatrix");
+  file.close();
+
+  remove(filename.c_str());
+}
+
+TEST_CASE("measurements_resume_close", "[measurements]") {
+
+  std::string filename = "test_file.h5";
+  remove(filename.c_str());
+  auto file = lime::FileH5(filename, "w");
+  auto m1 = lime::Measurements();
+  for (int idx = 0; idx < 10; ++idx)
+    m1["int"] << (int)idx;
+  m1.dump(file);
+  file.close();
+
+  // The resumed file is closed together with the measurements
+  {
+    file = lime::FileH5(filename, "a");
+    auto m2 = lime::Measurements();
+    m2.resume(file);
+    int entry;
+    m2["int"].get(3, entry);
+    REQUIRE(entry == 3);
+    file.close();
+  }
+  file = lime::FileH5(filename, "w!");
+  REQUIRE(file.fields().empty());
+  file.close();
+
+  remove(filename.c_str());
+}
@@ -0,0 +1,135 @@
+// Copyright 2018 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <fstream>
+
+#include "catch.hpp"
+
+#include <lila/all.h>
+#include <lime/all.h>
+
+using namespace lime;
+
+template <class data_t>
+void check_checkpoint_field_agrees(Measurements &m1, Measurements &m2,
+                                   std::string field) {
+  REQUIRE(m1[field].size() == m2[field].size());
+  for (long idx = 0; idx < m1[field].size(); ++idx) {
+    data_t d1, d2;
+    m1[field].get(idx, d1);
+    m2[field].get(idx, d2);
+    REQUIRE(d1 == d2);
+  }
+}
+
+void check_checkpoint_fields_agree(Measurements &m1, Measurements &m2) {
+  check_checkpoint_field_agrees<int>(m1, m2, "int");
+  check_checkpoint_field_agrees<dscalar>(m1, m2, "dscalar");
+  check_checkpoint_field_agrees<zscalar>(m1, m2, "zscalar");
+  check_checkpoint_field_agrees<dvector>(m1, m2, "dvector");
+  check_checkpoint_field_agrees<zmatrix>(m1, m2, "zmatrix");
+  check_checkpoint_field_agrees<Record>(m1, m2, "record");
+}
+
+TEST_CASE("measurements_checkpoint", "[measurements]") {
+
+  std::string filename = "test_file.h5";
+  std::string logname = "test_file.h5.log";
+  remove(filename.c_str());
+  remove(logname.c_str());
+
+  auto file = lime::FileH5(filename, "w");
+  auto m1 = lime::Measurements();
+  m1.checkpoint(logname, 3);
+  for (int idx = 0; idx < 10; ++idx) {
+    m1["int"] << (int)idx;
+    m1["dscalar"] << (dscalar)idx;
+    m1["zscalar"] << (zscalar)idx;
+    m1["dvector"] << lila::Random<dscalar>(5);
+    m1["zmatrix"] << lila::Random<zscalar>(5, 4);
+    Record record;
+    record.set("energy", (dscalar)idx);
+    record.set("sign", (zscalar)idx);
+    m1["record"] << record;
+    m1.dump(file);
+  }
+  // 10 dumps with fold interval 3, last fold after dump 9
+  REQUIRE(m1["int"].previous_dump() == 9);
+  file.close();
+
+  // Simulate a crash tearing the last record of the log
+  {
+    std::ofstream log(logname, std::ios::binary | std::ios::app);
+    log << "torn";
+  }
+
+  // Restart: file contents and log are combined
+  file = lime::FileH5(filename, "a");
+  auto m2 = lime::Measurements();
+  m2.checkpoint(logname, 3);
+  m2.read(file);
+  check_checkpoint_fields_agree(m1, m2);
+  REQUIRE(m2["int"].previous_dump() == 9);
+
+  // Folding writes the replayed measurements to the file
+  m2.fold(file);
+  REQUIRE(m2["int"].previous_dump() == 10);
+  file.close();
+
+  file = lime::FileH5(filename, "r");
+  auto m3 = lime::Measurements();
+  m3.read(file);
+  check_checkpoint_fields_agree(m1, m3);
+  file.close();
+
+  // Records logged after restarting behind a torn tail are replayed
+  file = lime::FileH5(filename, "a");
+  auto m4 = lime::Measurements();
+  m4.checkpoint(logname, 5);
+  m4.read(file);
+  for (int idx = 10; idx < 12; ++idx) {
+    m1["int"] << (int)idx;
+    m4["int"] << (int)idx;
+    m4.dump(file);
+  }
+  file.close();
+  {
+    std::ofstream log(logname, std::ios::binary | std::ios::app);
+    log << "torn";
+  }
+
+  file = lime::FileH5(filename, "a");
+  auto m5 = lime::Measurements();
+  m5.checkpoint(logname, 5);
+  m5.read(file);
+  for (int idx = 12; idx < 15; ++idx) {
+    m1["int"] << (int)idx;
+    m5["int"] << (int)idx;
+    m5.dump(file);
+  }
+  REQUIRE(m5["int"].previous_dump() == 10);
+  file.close();
+
+  file = lime::FileH5(filename, "a");
+  auto m6 = lime::Measurements();
+  m6.checkpoint(logname, 5);
+  m6.read(file);
+  REQUIRE(m6["int"].size() == 15);
+  check_checkpoint_field_agrees<int>(m1, m6, "int");
+  file.close();
+
+  remove(filename.c_str());
+  remove(logname.c_str());
+}
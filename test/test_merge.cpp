@@ -0,0 +1,106 @@
+// Copyright 2018 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <complex>
+#include <stdio.h>
+
+#include "catch.hpp"
+
+#include <lime/all.h>
+
+TEST_CASE("merge", "[merge]") {
+  std::vector<std::string> inputs = {"test_file_0.h5", "test_file_1.h5"};
+  std::string output = "test_file_merged.h5";
+
+  std::vector<double> scalars;
+  std::vector<lime::dvector> vectors;
+  for (std::size_t seg = 0; seg < inputs.size(); ++seg) {
+    remove(inputs[seg].c_str());
+    auto file = lime::FileH5(inputs[seg], "w");
+    for (int idx = 0; idx < 10; ++idx) {
+      scalars.push_back((double)(10 * seg + idx));
+      vectors.push_back(lila::Random<double>(4));
+      file["scalar"] << scalars.back();
+      file["vector"] << vectors.back();
+    }
+    file["static"] = 42;
+    file.close();
+  }
+
+  // Concatenate segments
+  remove(output.c_str());
+  lime::merge(inputs, output);
+  auto file = lime::FileH5(output, "r");
+  std::vector<double> scalars2;
+  std::vector<lime::dvector> vectors2;
+  int static2;
+  file["scalar"].read(scalars2);
+  file["vector"].read(vectors2);
+  file["static"].read(static2);
+  REQUIRE(scalars == scalars2);
+  REQUIRE(vectors.size() == vectors2.size());
+  for (std::size_t idx = 0; idx < vectors.size(); ++idx)
+    REQUIRE(lila::equal(vectors[idx], vectors2[idx]));
+  REQUIRE(static2 == 42);
+  file.close();
+
+  // Existing outputs are only overwritten if forced, inputs never
+  REQUIRE_THROWS(lime::merge(inputs, output));
+  lime::MergeOptions options;
+  options.force = true;
+  lime::merge(inputs, output, options);
+  REQUIRE_THROWS(lime::merge(inputs, inputs[0], options));
+  file = lime::FileH5(inputs[0], "r");
+  REQUIRE(file["scalar"].size() == 10);
+  file.close();
+
+  // Static fields with different values are rejected
+  file = lime::FileH5(inputs[1], "a");
+  file["seed"] = 1;
+  file.close();
+  file = lime::FileH5(inputs[0], "a");
+  file["seed"] = 0;
+  file.close();
+  remove(output.c_str());
+  REQUIRE_THROWS(lime::merge(inputs, output));
+  REQUIRE(!lime::exists(output));
+
+  // Stack seeds into groups
+  remove(output.c_str());
+  options = lime::MergeOptions();
+  options.stack = true;
+  options.labels = {"seed0", "seed1"};
+  lime::merge(inputs, output, options);
+  file = lime::FileH5(output, "r");
+  REQUIRE(file["seed0/scalar"].defined());
+  REQUIRE(file["seed1/vector"].extensible());
+  file["seed1/scalar"].read(scalars2);
+  REQUIRE(scalars2 ==
+          std::vector<double>(scalars.begin() + 10, scalars.end()));
+  file["seed1/seed"].read(static2);
+  REQUIRE(static2 == 1);
+  file.close();
+
+  // Incompatible shapes are rejected
+  remove(inputs[1].c_str());
+  file = lime::FileH5(inputs[1], "w");
+  file["vector"] << lila::Random<double>(5);
+  file.close();
+  remove(output.c_str());
+  REQUIRE_THROWS(lime::merge(inputs, output));
+  REQUIRE(!lime::exists(output));
+
+  for (auto input : inputs)
+    remove(input.c_str());
+  remove(output.c_str());
+}
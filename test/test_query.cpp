@@ -0,0 +1,77 @@
+// Copyright 2020 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+
+#include <lime/all.h>
+
+TEST_CASE("query", "[query]") {
+  std::vector<std::string> filenames;
+  for (int L : {8, 12, 16})
+    for (double T : {0.1, 0.2}) {
+      std::string filename =
+          "test_query_" + std::to_string(L) + "_" + std::to_string(T) + ".h5";
+      remove(filename.c_str());
+      auto file = lime::FileH5(filename, "w");
+      file["energy"] << 1.0;
+      file["energy"].set_attribute("L", L);
+      file["energy"].set_attribute("T", T);
+      file["energy"].set_attribute("model", L == 16 ? "ising" : "heisenberg");
+      file["group/magnetization"] << 0.5;
+      file["group/magnetization"].set_attribute("T", std::to_string(T));
+      file.close();
+      filenames.push_back(filename);
+    }
+  std::string empty = "test_query_empty.h5";
+  remove(empty.c_str());
+  lime::FileH5(empty, "w").close();
+  filenames.push_back(empty);
+
+  REQUIRE(lime::AttributeQuery("energy").select(filenames).size() == 6);
+  REQUIRE(lime::AttributeQuery("undefined").select(filenames).empty());
+
+  auto query = lime::AttributeQuery("energy");
+  query.equals("model", "heisenberg").equals("T", 0.1);
+  auto selected = query.select(filenames);
+  REQUIRE(selected == std::vector<std::string>({filenames[0], filenames[2]}));
+
+  query = lime::AttributeQuery("energy");
+  query.between("L", 10, 20).equals("T", 0.2, 1e-12);
+  selected = query.select(filenames);
+  REQUIRE(selected == std::vector<std::string>({filenames[3], filenames[5]}));
+
+  // Numbers written as text, conditions on missing or textual attributes
+  query = lime::AttributeQuery("group/magnetization");
+  query.between("T", 0.15, 0.25);
+  REQUIRE(query.select(filenames).size() == 3);
+  REQUIRE(lime::AttributeQuery("energy").defines("seed").select(filenames)
+              .empty());
+  REQUIRE(lime::AttributeQuery("energy").between("model", 0, 1).select(
+              filenames).empty());
+
+  // Conditions on attributes already read
+  std::map<std::string, std::string> attributes = {{"L", "12"},
+                                                   {"model", "ising"}};
+  REQUIRE(lime::AttributeQuery("energy").equals("L", 12).matches(attributes));
+  REQUIRE(!lime::AttributeQuery("energy").equals("model", "heisenberg")
+               .matches(attributes));
+  REQUIRE_THROWS(lime::AttributeQuery("energy").matches(
+      std::string("test_query_missing.h5")));
+
+  for (auto const &filename : filenames)
+    remove(filename.c_str());
+}
@@ -0,0 +1,128 @@
+// Copyright 2018 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <complex>
+#include <stdio.h>
+
+#include "catch.hpp"
+
+#include <lime/all.h>
+
+static std::vector<hsize_t> chunk_dims(std::string filename,
+                                       std::string field) {
+  auto file = lime::FileH5(filename, "r");
+  hid_t dataset_id = H5Dopen2(file.file_id(), field.c_str(), H5P_DEFAULT);
+  hid_t plist_id = H5Dget_create_plist(dataset_id);
+  std::vector<hsize_t> dims(3, 0);
+  int rank = (H5Pget_layout(plist_id) == H5D_CHUNKED)
+                 ? H5Pget_chunk(plist_id, 3, dims.data())
+                 : 0;
+  dims.resize(rank < 0 ? 0 : rank);
+  H5Pclose(plist_id);
+  H5Dclose(dataset_id);
+  file.close();
+  return dims;
+}
+
+TEST_CASE("repack", "[repack]") {
+  std::string filename = "test_file.h5";
+  std::string repacked = "test_file_repacked.h5";
+  remove(filename.c_str());
+  remove(repacked.c_str());
+
+  std::vector<double> scalars;
+  std::vector<lime::zmatrix> matrices;
+  auto file = lime::FileH5(filename, "w");
+  for (int idx = 0; idx < 50; ++idx) {
+    scalars.push_back((double)idx);
+    matrices.push_back(lila::Random<lime::zscalar>(3, 4));
+    file["scalar"] << scalars.back();
+    file["matrix"] << matrices.back();
+  }
+  file["static"] = lila::Random<double>(10);
+  file["static"].set_attribute("parameter", "value");
+  file.close();
+  REQUIRE(chunk_dims(filename, "matrix")[0] == 1);
+
+  auto check = [&](std::string name) {
+    auto fl = lime::FileH5(name, "r");
+    REQUIRE(fl["scalar"].extensible());
+    REQUIRE(fl["matrix"].extensible());
+    REQUIRE(!fl["static"].extensible());
+    REQUIRE(fl["static"].attribute("parameter") == "value");
+    std::vector<double> scalars2;
+    std::vector<lime::zmatrix> matrices2;
+    fl["scalar"].read(scalars2);
+    fl["matrix"].read(matrices2);
+    REQUIRE(scalars == scalars2);
+    REQUIRE(matrices.size() == matrices2.size());
+    for (std::size_t idx = 0; idx < matrices.size(); ++idx)
+      REQUIRE(lila::equal(matrices[idx], matrices2[idx]));
+    fl.close();
+  };
+
+  // Rechunked and compressed
+  lime::RepackOptions options;
+  options.compression = 4;
+  lime::repack(filename, repacked, options);
+  check(repacked);
+  REQUIRE(chunk_dims(repacked, "matrix")[0] ==
+          options.chunk_bytes / (3 * 4 * sizeof(lime::zscalar)));
+
+  // Rechunked fields can still be appended to
+  file = lime::FileH5(repacked, "a");
+  file["scalar"] << 50.0;
+  scalars.push_back(50.0);
+  file.close();
+  check(repacked);
+
+  // Contiguous fields can be mapped
+  options = lime::RepackOptions();
+  options.contiguous = true;
+  lime::repack(filename, repacked, options);
+  scalars.pop_back();
+  check(repacked);
+  REQUIRE(chunk_dims(repacked, "matrix").size() == 0);
+  file = lime::FileH5(repacked, "r");
+  auto mapped = file.map<double>("scalar");
+  REQUIRE(mapped.mapped());
+  REQUIRE(std::vector<double>(mapped.begin(), mapped.end()) == scalars);
+  file.close();
+
+  // Contiguous fields have a fixed extent
+  file = lime::FileH5(repacked, "a");
+  try {
+    file["scalar"] << 50.0;
+    FAIL("append to contiguous field");
+  } catch (std::runtime_error const &e) {
+    REQUIRE(std::string(e.what()).find("contiguous repack") !=
+            std::string::npos);
+  }
+  file.close();
+
+  // Failed repacks leave no partial output behind
+  remove(repacked.c_str());
+  options = lime::RepackOptions();
+  options.chunk_size = (hsize_t)1 << 33;
+  REQUIRE_THROWS(lime::repack(filename, repacked, options));
+  FILE *partial = fopen(repacked.c_str(), "r");
+  REQUIRE(partial == nullptr);
+  options.chunk_size = 0;
+  lime::repack(filename, repacked, options);
+  check(repacked);
+
+  remove(filename.c_str());
+  remove(repacked.c_str());
+}
@@ -0,0 +1,186 @@
+// Copyright 2020 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mutex>
+#include <set>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+
+#include "catch.hpp"
+
+#include <lime/all.h>
+#include <lime/hdf5/chunk_filters.h>
+#include <lime/hdf5/read_entries.h>
+#include <lime/hdf5/write_entries.h>
+
+using namespace lime;
+
+static hid_t create_dataset(hid_t file_id, std::string name, int filter) {
+  std::vector<hsize_t> dims = {0, 3};
+  std::vector<hsize_t> max_dims = {H5S_UNLIMITED, 3};
+  std::vector<hsize_t> chunk_dims = {8, 3};
+  hid_t plist_id = H5Pcreate(H5P_DATASET_CREATE);
+  H5Pset_chunk(plist_id, 2, chunk_dims.data());
+  if (filter == 1) {
+    H5Pset_shuffle(plist_id);
+    H5Pset_deflate(plist_id, 6);
+  } else if (filter == 2)
+    H5Pset_scaleoffset(plist_id, H5Z_SO_INT, H5Z_SO_INT_MINBITS_DEFAULT);
+  hid_t space_id = H5Screate_simple(2, dims.data(), max_dims.data());
+  hid_t dataset_id = H5Dcreate2(file_id, name.c_str(), H5T_NATIVE_LONG,
+                                space_id, H5P_DEFAULT, plist_id, H5P_DEFAULT);
+  H5Sclose(space_id);
+  H5Pclose(plist_id);
+  return dataset_id;
+}
+
+TEST_CASE("write_entries", "[hdf5]") {
+  std::string filename = "test_file.h5";
+  remove(filename.c_str());
+  auto file = FileH5(filename, "w");
+
+  // Unaligned ranges with complete chunks in between
+  std::vector<std::pair<hsize_t, hsize_t>> ranges = {
+      {0, 3}, {3, 5}, {8, 16}, {24, 3}, {27, 29}, {56, 1}, {57, 40}};
+  for (int filter = 0; filter < 3; ++filter) {
+    std::string name = "dataset" + std::to_string(filter);
+    hid_t dataset_id = create_dataset(file.file_id(), name, filter);
+    REQUIRE(hdf5::chunk_entries(dataset_id) == 8);
+    std::vector<long> values;
+    for (auto range : ranges) {
+      std::vector<long> entries(3 * range.second);
+      for (hsize_t idx = 0; idx < entries.size(); ++idx)
+        entries[idx] = (long)(3 * range.first + idx) % 17;
+      values.insert(values.end(), entries.begin(), entries.end());
+      std::vector<hsize_t> dims = {range.first + range.second, 3};
+      H5Dset_extent(dataset_id, dims.data());
+      hdf5::write_entries(dataset_id, H5T_NATIVE_LONG, range.first,
+                          range.second, entries.data());
+    }
+    H5Dclose(dataset_id);
+
+    dataset_id = H5Dopen2(file.file_id(), name.c_str(), H5P_DEFAULT);
+    std::vector<long> read(values.size());
+    H5Dread(dataset_id, H5T_NATIVE_LONG, H5S_ALL, H5S_ALL, H5P_DEFAULT,
+            read.data());
+    REQUIRE(read == values);
+    if (filter == 1) {
+      REQUIRE(H5Dget_storage_size(dataset_id) < values.size() * sizeof(long));
+    }
+    H5Dclose(dataset_id);
+  }
+
+  // Bulk appends of FileH5 write whole chunks directly
+  std::vector<dvector> vectors;
+  for (int idx = 0; idx < 1000; ++idx)
+    vectors.push_back(lila::Random<double>(4));
+  file["vectors"] << vectors[0];
+  file.append("vectors", vectors.data() + 1, 998);
+  file["vectors"] << vectors[999];
+  file.close();
+
+  file = FileH5(filename, "r");
+  std::vector<dvector> read;
+  file.read("vectors", read);
+  REQUIRE(read.size() == vectors.size());
+  for (int idx = 0; idx < 1000; ++idx)
+    REQUIRE(read[idx] == vectors[idx]);
+  file.close();
+
+  remove(filename.c_str());
+}
+
+TEST_CASE("read_entries", "[hdf5]") {
+  std::string filename = "test_file.h5";
+  remove(filename.c_str());
+  auto file = FileH5(filename, "w");
+
+  // Compressed chunks with an unwritten chunk in between
+  hid_t dataset_id = create_dataset(file.file_id(), "dataset", 1);
+  std::vector<long> values(3 * 104);
+  for (hsize_t idx = 0; idx < values.size(); ++idx)
+    values[idx] = (long)idx % 13;
+  std::vector<hsize_t> dims = {104, 3};
+  H5Dset_extent(dataset_id, dims.data());
+  hdf5::write_entries(dataset_id, H5T_NATIVE_LONG, 0, 40, values.data());
+  hdf5::write_entries(dataset_id, H5T_NATIVE_LONG, 48, 52,
+                      values.data() + 3 * 48);
+  hdf5::write_entries(dataset_id, H5T_NATIVE_LONG, 100, 4,
+                      values.data() + 3 * 100);
+  std::fill(values.begin() + 3 * 40, values.begin() + 3 * 48, 0);
+
+  // The last chunk is still in the chunk cache and is read as well
+  std::vector<std::pair<hsize_t, hsize_t>> ranges = {
+      {0, 104}, {3, 90}, {8, 32}, {17, 5}, {40, 16}, {88, 16}};
+  for (auto range : ranges) {
+    std::vector<long> read(3 * range.second);
+    hdf5::read_entries(dataset_id, H5T_NATIVE_LONG, range.first,
+                       range.second, read.data());
+    REQUIRE(std::equal(read.begin(), read.end(),
+                       values.begin() + 3 * range.first));
+  }
+  H5Dclose(dataset_id);
+
+  // Compressed fields are read in parallel by FileH5
+  std::vector<double> scalars;
+  for (int idx = 0; idx < 1234; ++idx)
+    scalars.push_back((double)(idx % 10));
+  file.append("scalars", scalars);
+  file.append("vectors", std::vector<dvector>(500, lila::Random<double>(4)));
+  file.close();
+  RepackOptions options;
+  options.compression = 6;
+  options.chunk_size = 16;
+  repack(filename, "test_repacked.h5", options);
+
+  file = FileH5("test_repacked.h5", "r");
+  std::vector<double> read;
+  file.read("scalars", read);
+  REQUIRE(read == scalars);
+  std::vector<dvector> vectors;
+  file.read("vectors", vectors);
+  REQUIRE(vectors.size() == 500);
+  dvector vector;
+  file.read("vectors", 123, vector);
+  REQUIRE(vectors[499] == vector);
+  file.close();
+
+  remove(filename.c_str());
+  remove("test_repacked.h5");
+}
+
+TEST_CASE("for_each_chunk", "[hdf5]") {
+  // Small amounts of work stay on the calling thread
+  std::mutex mutex;
+  std::set<std::thread::id> threads;
+  std::vector<int> visited(8, 0);
+  auto visit = [&](hsize_t idx) {
+    std::lock_guard<std::mutex> lock(mutex);
+    threads.insert(std::this_thread::get_id());
+    ++visited[idx];
+    return true;
+  };
+  REQUIRE(lime::hdf5::for_each_chunk(8, 1024, visit));
+  REQUIRE(threads == std::set<std::thread::id>({std::this_thread::get_id()}));
+  REQUIRE(visited == std::vector<int>(8, 1));
+
+  // Large ones are split among threads, every chunk is visited once
+  REQUIRE(lime::hdf5::for_each_chunk(8, LIME_FILTER_THREAD_BYTES, visit));
+  REQUIRE(visited == std::vector<int>(8, 2));
+  REQUIRE(!lime::hdf5::for_each_chunk(8, LIME_FILTER_THREAD_BYTES,
+                                      [](hsize_t idx) { return idx != 5; }));
+  REQUIRE(!lime::hdf5::for_each_chunk(8, 1024,
+                                      [](hsize_t idx) { return idx != 5; }));
+}
@@ -0,0 +1,99 @@
+// Copyright 2020 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <lime/catalog.h>
+#include <lime/filesystem.h>
+
+void usage() {
+  std::cerr
+      << "Usage: lime-catalog [options] catalog.h5 input1.h5 input2.h5 ...\n"
+      << "       lime-catalog --select catalog.h5 field [condition ...]\n"
+      << "Scans the fields of lime files into a catalog, or prints the files\n"
+      << "whose field matches all conditions name=value or name=min:max.\n"
+      << "Options:\n"
+      << "  --update         add the inputs to an existing catalog\n";
+}
+
+static bool parse_number(std::string const &text, double &number) {
+  char *end = nullptr;
+  number = std::strtod(text.c_str(), &end);
+  return !text.empty() && (*end == '\0');
+}
+
+static void add_condition(lime::AttributeQuery &query,
+                          std::string const &condition) {
+  size_t equal = condition.find('=');
+  if (equal == std::string::npos)
+    throw std::runtime_error("invalid condition: " + condition);
+  std::string name = condition.substr(0, equal);
+  std::string value = condition.substr(equal + 1);
+  size_t colon = value.find(':');
+  double number, max;
+  if ((colon != std::string::npos) &&
+      parse_number(value.substr(0, colon), number) &&
+      parse_number(value.substr(colon + 1), max))
+    query.between(name, number, max);
+  else if (parse_number(value, number))
+    query.equals(name, number);
+  else
+    query.equals(name, value);
+}
+
+int main(int argc, char *argv[]) {
+  bool select = false, update = false;
+  std::vector<std::string> args;
+  try {
+    for (int idx = 1; idx < argc; ++idx) {
+      std::string arg = argv[idx];
+      if (arg == "--select")
+        select = true;
+      else if (arg == "--update")
+        update = true;
+      else if ((arg.size() > 0) && (arg[0] == '-')) {
+        usage();
+        return 1;
+      } else
+        args.push_back(arg);
+    }
+    if (args.size() < 2) {
+      usage();
+      return 1;
+    }
+
+    if (select) {
+      lime::AttributeQuery query(args[1]);
+      for (size_t idx = 2; idx < args.size(); ++idx)
+        add_condition(query, args[idx]);
+      for (auto const &filename : lime::Catalog(args[0]).filenames(query))
+        std::cout << filename << "\n";
+    } else {
+      lime::Catalog catalog;
+      if (update && lime::exists(args[0]))
+        catalog = lime::Catalog(args[0]);
+      for (size_t idx = 1; idx < args.size(); ++idx)
+        catalog.add(args[idx]);
+      catalog.write(args[0]);
+    }
+  } catch (std::exception const &e) {
+    std::cerr << "lime-catalog: " << e.what() << "\n";
+    return 1;
+  }
+  return 0;
+}
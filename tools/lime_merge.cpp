@@ -0,0 +1,67 @@
+// Copyright 2020 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <lime/merge.h>
+
+void usage() {
+  std::cerr
+      << "Usage: lime-merge [options] output.h5 input1.h5 input2.h5 ...\n"
+      << "Concatenates extensible fields of the inputs into a new file.\n"
+      << "Options:\n"
+      << "  --stack          copy fields of each input into its own group\n"
+      << "  --labels A,B,..  group names of the inputs when stacking\n"
+      << "  --force          overwrite an existing output file\n";
+}
+
+int main(int argc, char *argv[]) {
+  lime::MergeOptions options;
+  std::string output;
+  std::vector<std::string> inputs;
+  try {
+    for (int idx = 1; idx < argc; ++idx) {
+      std::string arg = argv[idx];
+      if (arg == "--stack")
+        options.stack = true;
+      else if (arg == "--force")
+        options.force = true;
+      else if ((arg == "--labels") && (idx + 1 < argc)) {
+        std::stringstream labels(argv[++idx]);
+        std::string label;
+        while (std::getline(labels, label, ','))
+          options.labels.push_back(label);
+      } else if ((arg.size() > 0) && (arg[0] == '-')) {
+        usage();
+        return 1;
+      } else if (output.empty())
+        output = arg;
+      else
+        inputs.push_back(arg);
+    }
+    if (output.empty() || inputs.empty()) {
+      usage();
+      return 1;
+    }
+    lime::merge(inputs, output, options);
+  } catch (std::exception const &e) {
+    std::cerr << "lime-merge: " << e.what() << "\n";
+    return 1;
+  }
+  return 0;
+}
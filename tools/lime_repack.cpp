@@ -0,0 +1,100 @@
+// Copyright 2020 Alexander Wietek - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdio>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include <lime/repack.h>
+
+void usage() {
+  std::cerr
+      << "Usage: lime-repack [options] input.h5 [output.h5]\n"
+      << "Rewrites the lime fields of a file, in place if no output given.\n"
+      << "Options:\n"
+      << "  --chunk-bytes N  target size of chunks in bytes (default 1MB)\n"
+      << "  --chunk-size N   number of entries per chunk\n"
+      << "  --compression L  deflate compression level 1-9\n"
+      << "  --contiguous     store extensible fields contiguously\n"
+      << "  --group G        only repack the fields of group G, needs an\n"
+      << "                   output file\n"
+      << "  --latest-format  write with the newest hdf5 file format\n"
+      << "  --alignment N    align objects to multiples of N bytes\n"
+      << "  --paged          paged aggregation of file space\n";
+}
+
+int main(int argc, char *argv[]) {
+  lime::RepackOptions options;
+  std::string input, output;
+  try {
+    for (int idx = 1; idx < argc; ++idx) {
+      std::string arg = argv[idx];
+      bool has_value = (idx + 1 < argc);
+      if ((arg == "--chunk-bytes") && has_value)
+        options.chunk_bytes = std::stoull(argv[++idx]);
+      else if ((arg == "--chunk-size") && has_value)
+        options.chunk_size = std::stoull(argv[++idx]);
+      else if ((arg == "--compression") && has_value)
+        options.compression = std::stoi(argv[++idx]);
+      else if (arg == "--contiguous")
+        options.contiguous = true;
+      else if ((arg == "--group") && has_value)
+        options.group = argv[++idx];
+      else if (arg == "--latest-format")
+        options.file.latest_format = true;
+      else if ((arg == "--alignment") && has_value)
+        options.file.alignment = std::stoull(argv[++idx]);
+      else if (arg == "--paged")
+        options.file.paged_aggregation = true;
+      else if ((arg.size() > 0) && (arg[0] == '-')) {
+        usage();
+        return 1;
+      } else if (input.empty())
+        input = arg;
+      else if (output.empty())
+        output = arg;
+      else {
+        usage();
+        return 1;
+      }
+    }
+    if (input.empty()) {
+      usage();
+      return 1;
+    }
+
+    // Fields outside the group would be lost when repacking in place
+    if (!options.group.empty() && output.empty()) {
+      std::cerr << "lime-repack: --group requires an output file\n";
+      return 1;
+    }
+
+    // Repack in place via a temporary file
+    if (output.empty()) {
+      std::string tmp = input + ".repack";
+      lime::repack(input, tmp, options);
+      if (std::rename(tmp.c_str(), input.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        std::cerr << "lime-repack: can't replace " << input << "\n";
+        return 1;
+      }
+    } else
+      lime::repack(input, output, options);
+  } catch (std::exception const &e) {
+    std::cerr << "lime-repack: " << e.what() << "\n";
+    return 1;
+  }
+  return 0;
+}